@@ -0,0 +1,55 @@
+from dynd import nd, ndt
+
+import matplotlib
+import matplotlib.pyplot
+
+from benchrun import Benchmark, median
+from benchtime import Timer
+
+size = [10, 100, 1000, 10000, 100000, 1000000, 10000000]
+
+class AsPyBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, type):
+    Benchmark.__init__(self)
+    self.type = type
+
+  @median
+  def run(self, size):
+    a = nd.array([i % 1000 for i in range(size)], type = ndt.type('{} * {}'.format(size, self.type)))
+
+    with Timer() as timer:
+      nd.as_py(a)
+
+    return timer.elapsed_time()
+
+class NumPyToListBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, type):
+    Benchmark.__init__(self)
+    self.type = type
+
+  @median
+  def run(self, size):
+    import numpy as np
+
+    a = np.array([i % 1000 for i in range(size)], dtype = self.type)
+
+    with Timer() as timer:
+      a.tolist()
+
+    return timer.elapsed_time()
+
+if __name__ == '__main__':
+  for type in ['float64', 'int32']:
+    benchmark = AsPyBenchmark(type)
+    benchmark.plot_result(loglog = True)
+
+    benchmark = NumPyToListBenchmark(type)
+    benchmark.plot_result(loglog = True)
+
+  matplotlib.pyplot.show()
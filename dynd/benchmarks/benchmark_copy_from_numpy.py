@@ -0,0 +1,73 @@
+from dynd import nd, ndt
+
+import numpy as np
+
+import matplotlib
+import matplotlib.pyplot
+
+from benchrun import Benchmark, median
+from benchtime import Timer
+
+size = [10, 100, 1000, 10000, 100000, 1000000, 10000000]
+
+struct_dtype = np.dtype([('id', np.int64), ('value', np.float64), ('flag', np.int8)])
+
+def make_array(kind, size):
+  if kind == 'contiguous':
+    return np.arange(size, dtype=np.float64)
+  elif kind == 'strided':
+    return np.arange(2 * size, dtype=np.float64)[::2]
+  elif kind == 'struct':
+    a = np.empty(size, dtype=struct_dtype)
+    a['id'] = np.arange(size)
+    a['value'] = 0.5
+    a['flag'] = 1
+    return a
+  elif kind == 'object':
+    return np.array(['name{}'.format(i % 100) for i in range(size)], dtype=object)
+
+  raise ValueError('unknown array kind {}'.format(kind))
+
+class CopyFromNumPyBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, kind):
+    Benchmark.__init__(self)
+    self.kind = kind
+
+  @median
+  def run(self, size):
+    a = make_array(self.kind, size)
+
+    with Timer() as timer:
+      nd.array(a)
+
+    return timer.elapsed_time()
+
+class NumPyCopyBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, kind):
+    Benchmark.__init__(self)
+    self.kind = kind
+
+  @median
+  def run(self, size):
+    a = make_array(self.kind, size)
+
+    with Timer() as timer:
+      np.copy(a)
+
+    return timer.elapsed_time()
+
+if __name__ == '__main__':
+  for kind in ['contiguous', 'strided', 'struct', 'object']:
+    benchmark = CopyFromNumPyBenchmark(kind)
+    benchmark.plot_result(loglog = True)
+
+    benchmark = NumPyCopyBenchmark(kind)
+    benchmark.plot_result(loglog = True)
+
+  matplotlib.pyplot.show()
@@ -0,0 +1,69 @@
+from dynd import nd, ndt
+
+import matplotlib
+import matplotlib.pyplot
+
+from benchrun import Benchmark, median
+from benchtime import Timer
+
+size = [10, 100, 1000, 10000, 100000, 1000000, 10000000]
+
+def make_list(kind, size):
+  import random
+
+  if kind == 'float64':
+    return [random.uniform(-1, 1) for i in range(size)]
+  elif kind == 'int64':
+    return [random.randint(-2 ** 40, 2 ** 40) for i in range(size)]
+  elif kind == 'bool':
+    return [random.random() < 0.5 for i in range(size)]
+  elif kind == 'string':
+    return ['item{}'.format(random.randint(0, size)) for i in range(size)]
+
+  raise ValueError('unknown list kind {}'.format(kind))
+
+class ListIngestBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, kind):
+    Benchmark.__init__(self)
+    self.kind = kind
+
+  @median
+  def run(self, size):
+    lst = make_list(self.kind, size)
+
+    with Timer() as timer:
+      nd.array(lst)
+
+    return timer.elapsed_time()
+
+class NumPyListIngestBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, kind):
+    Benchmark.__init__(self)
+    self.kind = kind
+
+  @median
+  def run(self, size):
+    import numpy as np
+
+    lst = make_list(self.kind, size)
+
+    with Timer() as timer:
+      np.array(lst)
+
+    return timer.elapsed_time()
+
+if __name__ == '__main__':
+  for kind in ['float64', 'int64', 'bool', 'string']:
+    benchmark = ListIngestBenchmark(kind)
+    benchmark.plot_result(loglog = True)
+
+    benchmark = NumPyListIngestBenchmark(kind)
+    benchmark.plot_result(loglog = True)
+
+  matplotlib.pyplot.show()
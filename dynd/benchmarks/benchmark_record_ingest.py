@@ -0,0 +1,53 @@
+from __future__ import print_function
+
+from dynd import nd, ndt
+
+import matplotlib
+import matplotlib.pyplot
+
+from benchrun import Benchmark, median
+from benchtime import Timer
+
+size = [10, 100, 1000, 10000, 100000, 1000000]
+
+record_type = ndt.type('{id: int64, name: string, value: float64}')
+
+def make_records(kind, size):
+  import random
+
+  if kind == 'tuple':
+    return [(i, 'name{}'.format(i % 100), random.uniform(-1, 1)) for i in range(size)]
+  elif kind == 'dict':
+    return [{'id': i, 'name': 'name{}'.format(i % 100), 'value': random.uniform(-1, 1)} for i in range(size)]
+
+  raise ValueError('unknown record kind {}'.format(kind))
+
+class RecordIngestBenchmark(Benchmark):
+  parameters = ('size',)
+  size = size
+
+  def __init__(self, kind):
+    Benchmark.__init__(self)
+    self.kind = kind
+
+  @median
+  def run(self, size):
+    records = make_records(self.kind, size)
+
+    with Timer() as timer:
+      nd.array(records, type = ndt.make_fixed_dim(size, record_type))
+
+    return timer.elapsed_time()
+
+  def print_rows_per_second(self):
+    print(self.__class__.__name__, self.kind)
+    for size, t in self.results:
+      print('  {:>10} rows: {:>14.0f} rows/sec'.format(size, size / t))
+
+if __name__ == '__main__':
+  for kind in ['tuple', 'dict']:
+    benchmark = RecordIngestBenchmark(kind)
+    benchmark.plot_result(loglog = True)
+    benchmark.print_rows_per_second()
+
+  matplotlib.pyplot.show()
@@ -30,3 +30,31 @@ DyND_BroadcastException = <PyObject*>BroadcastError
 
 def load(name):
     _load(name)
+
+def numpy_type_cache_info():
+    """
+    numpy_type_cache_info()
+    Returns the counters of the caches of conversions between NumPy
+    dtypes and dynd types, as a dict. 'dtype_hits' and 'dtype_misses'
+    count the conversions of struct, subarray and datetime dtypes to dynd
+    types, 'type_hits' and 'type_misses' the conversions of struct and
+    string types to NumPy dtypes, and 'size' is the number of cached
+    conversions.
+    """
+    from .ndt.type import _numpy_type_cache_info as type_info
+    from .nd.array import _numpy_type_cache_info as array_info
+    result = type_info()
+    for key, value in array_info().items():
+        result[key] += value
+    return result
+
+def clear_numpy_type_cache():
+    """
+    clear_numpy_type_cache()
+    Empties the caches of conversions between NumPy dtypes and dynd
+    types, and resets their counters.
+    """
+    from .ndt.type import _clear_numpy_type_cache as clear_type
+    from .nd.array import _clear_numpy_type_cache as clear_array
+    clear_type()
+    clear_array()
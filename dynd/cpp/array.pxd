@@ -1,5 +1,5 @@
 from ..config cimport translate_exception
-from libc.stdint cimport intptr_t
+from libc.stdint cimport intptr_t, uint64_t
 from libcpp cimport bool
 from libcpp.map cimport map
 from libcpp.string cimport string
@@ -26,6 +26,7 @@ cdef extern from 'dynd/array.hpp' namespace 'dynd::nd' nogil:
         type get_dtype()
         type get_dtype(size_t)
         intptr_t get_ndim()
+        uint64_t get_flags()
         intptr_t get_dim_size() except +translate_exception
         intptr_t get_dim_size(intptr_t) except +translate_exception
 
@@ -21,6 +21,7 @@ cdef extern from 'dynd/type.hpp' namespace 'dynd::ndt' nogil:
         size_t get_data_alignment()
         size_t get_arrmeta_size()
         type get_canonical_type()
+        type with_replaced_dtype(type&) except +translate_exception
 
         map[string, property_t] get_properties()
 
@@ -33,6 +33,23 @@ std::string make_pep3118_format(intptr_t &out_itemsize,
 PYDYND_API int array_getbuffer_pep3118(PyObject *ndo, Py_buffer *buffer,
                                        int flags);
 
+/**
+ * \brief Exports a ragged array of type ``[fixed dims *] var * T`` as a packed
+ *        ``M * T`` data array and an ``R + 1 * int64`` array of row offsets,
+ *        both of which support the PEP 3118 buffer protocol.
+ *
+ * The leading fixed dimensions are flattened in C order into ``R`` rows, and
+ * row ``r`` is ``data[offsets[r]:offsets[r + 1]]``. If the rows are already
+ * stored back to back, ``out_data`` views the original memory. Otherwise rows
+ * of an element type without arrmeta or references are packed into a copy.
+ *
+ * \param a  The ragged array to export.
+ * \param out_data  Filled with the packed elements.
+ * \param out_offsets  Filled with the row offsets.
+ */
+PYDYND_API void array_as_packed_pep3118(const dynd::nd::array &a, dynd::nd::array &out_data,
+                                        dynd::nd::array &out_offsets);
+
 /**
  * \brief Frees a previously created PEP3118 buffer.
  */
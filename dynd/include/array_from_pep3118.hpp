@@ -0,0 +1,44 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#pragma once
+
+#include <Python.h>
+
+#include <dynd/array.hpp>
+
+#include "visibility.hpp"
+
+namespace pydynd {
+
+/**
+ * \brief Converts a PEP 3118 format string into a dynd type.
+ *
+ * Supports the native, standard size and byte order prefixes for native
+ * byte order, repeat counts, subarray shapes, field names and nested
+ * ``T{...}`` structs. Struct fields keep the layout given by the format,
+ * which dynd stores in the arrmeta, so this only returns the type.
+ *
+ * \param format  The PEP 3118 format string.
+ * \param out_itemsize  Filled with the number of bytes the format describes.
+ */
+PYDYND_API dynd::ndt::type make_type_from_pep3118_format(const char *format, intptr_t &out_itemsize);
+
+/**
+ * \brief Views the memory of a PEP 3118 buffer exporter as an nd::array.
+ *
+ * The buffer is requested with ``PyBUF_RECORDS_RO``, or ``PyBUF_RECORDS`` if
+ * write access is requested, and is released when the array data is freed.
+ * A view requires aligned data in native byte order, while a copy of any
+ * other buffer is made byte by byte.
+ *
+ * \param obj  An object supporting the buffer protocol.
+ * \param access_flags  Either 0 to inherit the buffer's access flags, or the
+ *                      access flags for the result.
+ * \param always_copy  If true, produce a copy instead of a view.
+ */
+PYDYND_API dynd::nd::array array_from_pep3118(PyObject *obj, uint32_t access_flags, bool always_copy);
+
+} // namespace pydynd
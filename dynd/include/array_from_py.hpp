@@ -31,6 +31,50 @@ namespace pydynd {
  */
 PYDYND_API dynd::nd::array array_from_py(PyObject *obj, uint32_t access_flags, bool always_copy);
 
+/**
+ * Converts a nested Python sequence of bool, int, float, complex
+ * or str scalars into an nd::array in a single pass, speculatively typing
+ * the elements and promoting the buffer in place when a wider
+ * scalar is seen. Nested lists and tuples are read directly, any
+ * other outer sequence is materialized with PySequence_Fast first.
+ *
+ * \param obj  The Python sequence to convert.
+ * \param encode_strings  If true, a sequence of strings with few distinct
+ *                        values is interned and returned as a categorical
+ *                        array instead of a string array.
+ *
+ * \returns  The converted array, or a NULL nd::array if the sequence
+ *           requires the general deduction (ragged or empty
+ *           dimensions, mixed or unsupported scalars, ints beyond 64 bits).
+ */
+PYDYND_API dynd::nd::array array_from_pyseq_speculative(PyObject *obj, bool encode_strings = false);
+
+/**
+ * Builds a one-dimensional nd::array by consuming a Python
+ * iterable exactly once, without materializing it as a list.
+ *
+ * \param obj  The iterable (e.g. a generator or database cursor).
+ * \param dtp  The scalar element type of the result.
+ * \param count  The number of elements to read, or -1 to read until the
+ *               iterator is exhausted. With a count, the result is a fixed
+ *               dimension and it is an error for the iterator to be shorter,
+ *               otherwise the result is a var dimension which grows
+ *               geometrically as chunks of the iterator are consumed.
+ */
+PYDYND_API dynd::nd::array array_from_pyiter(PyObject *obj, const dynd::ndt::type &dtp, intptr_t count);
+
+/**
+ * Converts a Python sequence of datetime.datetime or datetime.date values,
+ * or of datetime.timedelta values, into a one-dimensional int64 array of
+ * ticks, counted from 1970-01-01 for dates, the same as numpy's datetime64
+ * and timedelta64. None becomes NaT.
+ *
+ * \param obj  The Python sequence to convert.
+ * \param unit  The numpy name of the tick unit, one of "W", "D", "h", "m",
+ *              "s", "ms", "us" or "ns".
+ */
+PYDYND_API dynd::nd::array array_from_pydatetimes(PyObject *obj, const std::string &unit);
+
 void init_array_from_py();
 
 } // namespace pydynd
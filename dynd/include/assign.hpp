@@ -14,10 +14,51 @@
 
 PYDYND_API void assign_init();
 
+/**
+ * How the pyobject assignment kernels export dynd struct values to Python.
+ *
+ * The pyobject export callables forward their resolve ``data`` to the
+ * callables of their elements. It is either null, which exports structs as
+ * dicts, or points to the mode given to ``array_as_py``.
+ */
+enum struct_export_mode_t { struct_export_dict, struct_export_tuple, struct_export_namedtuple };
+
+/**
+ * Converts a dynd array into Python objects, as nd.as_py does.
+ *
+ * \param a  The array to convert.
+ * \param records  How to export struct values, one of "dict", "tuple"
+ *                 or "namedtuple".
+ *
+ * \returns  A new reference to the converted object.
+ */
+PYDYND_API PyObject *array_as_py(const dynd::nd::array &a, const std::string &records);
+
+/**
+ * Sets how array_copy_to_numpy splits large copies across threads.
+ *
+ * \param grain_size  The approximate number of bytes copied by each task.
+ * \param threshold  The number of bytes below which copies run serially.
+ * \param max_threads  The maximum number of threads, or 0 to use the
+ *                     hardware concurrency.
+ */
+PYDYND_API void set_numpy_copy_threading(intptr_t grain_size, intptr_t threshold, intptr_t max_threads);
+
+/**
+ * Gets the settings made by set_numpy_copy_threading.
+ */
+PYDYND_API void get_numpy_copy_threading(intptr_t &out_grain_size, intptr_t &out_threshold, intptr_t &out_max_threads);
+
 #if DYND_NUMPY_INTEROP
 
 extern dynd::nd::callable assign_to_pyarrayobject;
 
+/**
+ * Copies a dynd array into a numpy array. When neither side holds Python
+ * objects and the copy is at least the threading threshold in bytes, the
+ * outer dimension is split into tasks of about the grain size in bytes,
+ * which run on a pool of threads with the GIL released.
+ */
 void array_copy_to_numpy(PyArrayObject *dst_arr, const dynd::ndt::type &src_tp, const char *src_arrmeta,
                          const char *src_data);
 
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <dynd/callables/base_callable.hpp>
+
+#include "kernels/apply_pyobject_chunk_kernel.hpp"
+
+namespace pydynd {
+namespace nd {
+  namespace functional {
+
+    /**
+     * A callable for a Python function which processes whole chunks of elements, see
+     * apply_pyobject_chunk_kernel. Used elementwise, each strided loop becomes one call per chunk.
+     */
+    class apply_pyobject_chunk_callable : public dynd::nd::base_callable {
+      PyObject *m_func;
+      intptr_t m_chunk_size;
+      dynd::ndt::type m_dst_tp;
+
+    public:
+      apply_pyobject_chunk_callable(const dynd::ndt::type &tp, PyObject *func, intptr_t chunk_size)
+          : dynd::nd::base_callable(tp), m_func(func), m_chunk_size(chunk_size),
+            m_dst_tp(tp.extended<dynd::ndt::callable_type>()->get_return_type())
+      {
+        Py_INCREF(m_func);
+      }
+
+      ~apply_pyobject_chunk_callable()
+      {
+        PyGILState_RAII pgs;
+        Py_DECREF(m_func);
+      }
+
+      dynd::ndt::type resolve(dynd::nd::base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data),
+                              dynd::nd::call_graph &cg, const dynd::ndt::type &DYND_UNUSED(dst_tp), size_t nsrc,
+                              const dynd::ndt::type *src_tp, size_t DYND_UNUSED(nkwd),
+                              const dynd::nd::array *DYND_UNUSED(kwds),
+                              const std::map<std::string, dynd::ndt::type> &DYND_UNUSED(tp_vars))
+      {
+        // The chunks are viewed with the concrete argument types, which may be more specific than the signature
+        std::vector<dynd::ndt::type> chunk_src_tp(src_tp, src_tp + nsrc);
+        PyObject *func = m_func;
+        intptr_t chunk_size = m_chunk_size;
+        dynd::ndt::type chunk_dst_tp = m_dst_tp;
+        cg.emplace_back([func, chunk_size, chunk_dst_tp, chunk_src_tp](
+            dynd::nd::kernel_builder &kb, dynd::kernel_request_t kernreq, char *DYND_UNUSED(data),
+            const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+          kb.emplace_back<apply_pyobject_chunk_kernel>(kernreq, func, chunk_size, chunk_dst_tp, chunk_src_tp,
+                                                       dst_arrmeta, src_arrmeta);
+        });
+
+        return m_dst_tp;
+      }
+    };
+
+  } // namespace pydynd::nd::functional
+} // namespace pydynd::nd
+} // namespace pydynd
@@ -142,12 +142,12 @@ namespace nd {
         intptr_t root_ckb_offset = kb.size();
         kb.emplace_back<assign_from_pyobject_kernel<dynd::ndt::option_type>>(kernreq, dst_tp, dst_arrmeta);
         intptr_t ckb_offset = kb.size();
-        kb(dynd::kernel_request_single, nullptr, dst_arrmeta, nsrc, nullptr);
+        kb(dynd::kernel_request_strided, nullptr, dst_arrmeta, nsrc, nullptr);
 
         ckb_offset = kb.size();
         kb.get_at<assign_from_pyobject_kernel<ndt::option_type>>(root_ckb_offset)->copy_value_offset =
             ckb_offset - root_ckb_offset;
-        kb(dynd::kernel_request_single, nullptr, dst_arrmeta, nsrc, src_arrmeta);
+        kb(dynd::kernel_request_strided, nullptr, dst_arrmeta, nsrc, src_arrmeta);
 
         ckb_offset = kb.size();
       });
@@ -218,7 +218,7 @@ namespace nd {
           self = kb.get_at<assign_from_pyobject_kernel<ndt::tuple_type>>(root_ckb_offset);
           self->m_copy_el_offsets[i] = ckb_offset - root_ckb_offset;
           const char *field_arrmeta = dst_arrmeta + arrmeta_offsets[i];
-          kb(dynd::kernel_request_single, nullptr, field_arrmeta, nsrc, src_arrmeta);
+          kb(dynd::kernel_request_strided, nullptr, field_arrmeta, nsrc, src_arrmeta);
           ckb_offset = kb.size();
         }
       });
@@ -289,15 +289,12 @@ namespace nd {
         intptr_t ckb_offset = kb.size();
         intptr_t root_ckb_offset = ckb_offset;
 
-        kb.emplace_back<assign_from_pyobject_kernel<ndt::struct_type>>(kernreq);
+        kb.emplace_back<assign_from_pyobject_kernel<ndt::struct_type>>(kernreq, dst_tp, dst_arrmeta, dim_broadcast);
 
         assign_from_pyobject_kernel<ndt::struct_type> *self =
             kb.get_at<assign_from_pyobject_kernel<ndt::struct_type>>(root_ckb_offset);
         ckb_offset = kb.size();
 
-        self->m_dst_tp = dst_tp;
-        self->m_dst_arrmeta = dst_arrmeta;
-        self->m_dim_broadcast = dim_broadcast;
         self->m_copy_el_offsets.resize(field_count);
 
         for (intptr_t i = 0; i < field_count; ++i) {
@@ -305,7 +302,7 @@ namespace nd {
           self = kb.get_at<assign_from_pyobject_kernel<ndt::struct_type>>(root_ckb_offset);
           self->m_copy_el_offsets[i] = ckb_offset - root_ckb_offset;
           const char *field_arrmeta = dst_arrmeta + arrmeta_offsets[i];
-          kb(dynd::kernel_request_single, nullptr, field_arrmeta, nsrc, src_arrmeta);
+          kb(dynd::kernel_request_strided, nullptr, field_arrmeta, nsrc, src_arrmeta);
           ckb_offset = kb.size();
         }
       });
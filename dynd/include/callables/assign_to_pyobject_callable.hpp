@@ -1,5 +1,6 @@
 #pragma once
 
+#include "assign.hpp"
 #include "kernels/assign_to_pyobject_kernel.hpp"
 #include <dynd/callables/base_callable.hpp>
 
@@ -158,7 +159,7 @@ namespace nd {
     {
     }
 
-    ndt::type resolve(dynd::nd::base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), dynd::nd::call_graph &cg,
+    ndt::type resolve(dynd::nd::base_callable *DYND_UNUSED(caller), char *data, dynd::nd::call_graph &cg,
                       const dynd::ndt::type &dst_tp, size_t nsrc, const dynd::ndt::type *src_tp,
                       size_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
                       const std::map<std::string, dynd::ndt::type> &tp_vars)
@@ -171,17 +172,17 @@ namespace nd {
 
         assign_to_pyobject_kernel<ndt::option_type> *self_ck =
             kb.get_at<assign_to_pyobject_kernel<ndt::option_type>>(root_ckb_offset);
-        kb(dynd::kernel_request_single, nullptr, nullptr, nsrc, src_arrmeta);
+        kb(dynd::kernel_request_strided, nullptr, nullptr, nsrc, src_arrmeta);
 
         self_ck = kb.get_at<assign_to_pyobject_kernel<ndt::option_type>>(root_ckb_offset);
         self_ck->m_assign_value_offset = kb.size() - root_ckb_offset;
 
-        kb(dynd::kernel_request_single, nullptr, dst_arrmeta, nsrc, src_arrmeta);
+        kb(dynd::kernel_request_strided, nullptr, dst_arrmeta, nsrc, src_arrmeta);
       });
 
       dynd::nd::is_na->resolve(this, nullptr, cg, dynd::ndt::make_type<dynd::bool1>(), nsrc, src_tp, 0, nullptr,
                                tp_vars);
-      dynd::nd::assign->resolve(this, nullptr, cg, dst_tp, nsrc, &src_value_tp, 0, NULL, tp_vars);
+      dynd::nd::assign->resolve(this, data, cg, dst_tp, nsrc, &src_value_tp, 0, NULL, tp_vars);
 
       return dst_tp;
     }
@@ -208,6 +209,33 @@ namespace nd {
     */
   };
 
+  template <>
+  class assign_to_pyobject_callable<ndt::categorical_type> : public dynd::nd::base_callable {
+  public:
+    assign_to_pyobject_callable()
+        : dynd::nd::base_callable(dynd::ndt::make_type<dynd::ndt::callable_type>(
+              dynd::ndt::make_type<pyobject_type>(), {dynd::ndt::make_type<ndt::categorical_kind_type>()}))
+    {
+    }
+
+    ndt::type resolve(dynd::nd::base_callable *DYND_UNUSED(caller), char *data, dynd::nd::call_graph &cg,
+                      const dynd::ndt::type &dst_tp, size_t DYND_UNUSED(nsrc), const dynd::ndt::type *src_tp,
+                      size_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
+                      const std::map<std::string, dynd::ndt::type> &DYND_UNUSED(tp_vars))
+    {
+      ndt::type src0_tp = src_tp[0];
+      // Struct categories follow the records mode given to array_as_py
+      struct_export_mode_t mode = data != nullptr ? *reinterpret_cast<struct_export_mode_t *>(data) : struct_export_dict;
+      cg.emplace_back([src0_tp, mode](dynd::nd::kernel_builder &kb, dynd::kernel_request_t kernreq,
+                                      char *DYND_UNUSED(data), const char *DYND_UNUSED(dst_arrmeta),
+                                      size_t DYND_UNUSED(nsrc), const char *const *DYND_UNUSED(src_arrmeta)) {
+        kb.emplace_back<assign_to_pyobject_kernel<ndt::categorical_type>>(kernreq, src0_tp, mode);
+      });
+
+      return dst_tp;
+    }
+  };
+
   template <>
   class assign_to_pyobject_callable<ndt::tuple_type> : public dynd::nd::base_callable {
   public:
@@ -265,7 +293,7 @@ namespace nd {
     {
     }
 
-    ndt::type resolve(dynd::nd::base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), dynd::nd::call_graph &cg,
+    ndt::type resolve(dynd::nd::base_callable *DYND_UNUSED(caller), char *data, dynd::nd::call_graph &cg,
                       const dynd::ndt::type &dst_tp, size_t nsrc, const dynd::ndt::type *src_tp,
                       size_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
                       const std::map<std::string, dynd::ndt::type> &tp_vars)
@@ -276,7 +304,9 @@ namespace nd {
           src_tp[0].extended<dynd::ndt::struct_type>()->get_arrmeta_offsets();
 
       ndt::type src0_tp = src_tp[0];
-      cg.emplace_back([src0_tp, arrmeta_offsets, field_count](
+      // The data of the export callables is either null or the records mode given to array_as_py
+      struct_export_mode_t mode = data != nullptr ? *reinterpret_cast<struct_export_mode_t *>(data) : struct_export_dict;
+      cg.emplace_back([src0_tp, arrmeta_offsets, field_count, mode](
           dynd::nd::kernel_builder &kb, dynd::kernel_request_t kernreq, char *DYND_UNUSED(data),
           const char *dst_arrmeta, size_t nsrc, const char *const *src_arrmeta) {
         intptr_t ckb_offset = kb.size();
@@ -295,6 +325,8 @@ namespace nd {
           pydynd::pyobject_ownref name(PyUnicode_DecodeUTF8(rawname.begin(), rawname.end() - rawname.begin(), NULL));
           PyTuple_SET_ITEM(self_ck->m_field_names.get(), i, name.release());
         }
+        self_ck->m_mode = mode;
+        self_ck->init_template();
         self_ck->m_copy_el_offsets.resize(field_count);
 
         for (intptr_t i = 0; i < field_count; ++i) {
@@ -309,7 +341,7 @@ namespace nd {
       });
 
       for (intptr_t i = 0; i < field_count; ++i) {
-        dynd::nd::assign->resolve(this, nullptr, cg, dst_tp, nsrc, &field_types[i], 0, nullptr, tp_vars);
+        dynd::nd::assign->resolve(this, data, cg, dst_tp, nsrc, &field_types[i], 0, nullptr, tp_vars);
       }
 
       return dst_tp;
@@ -362,22 +394,23 @@ namespace nd {
     {
     }
 
-    ndt::type resolve(dynd::nd::base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), dynd::nd::call_graph &cg,
+    ndt::type resolve(dynd::nd::base_callable *DYND_UNUSED(caller), char *data, dynd::nd::call_graph &cg,
                       const dynd::ndt::type &dst_tp, size_t nsrc, const dynd::ndt::type *src_tp, size_t nkwd,
                       const dynd::nd::array *kwds, const std::map<std::string, dynd::ndt::type> &tp_vars)
     {
-      cg.emplace_back([](dynd::nd::kernel_builder &kb, dynd::kernel_request_t kernreq, char *DYND_UNUSED(data),
-                         const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
+      dynd::ndt::type src_element_tp[1] = {src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type()};
+      dynd::ndt::type el_tp = src_element_tp[0];
+      cg.emplace_back([el_tp](dynd::nd::kernel_builder &kb, dynd::kernel_request_t kernreq, char *DYND_UNUSED(data),
+                              const char *dst_arrmeta, size_t DYND_UNUSED(nsrc), const char *const *src_arrmeta) {
         const char *src_element_arrmeta[1] = {src_arrmeta[0] + sizeof(size_stride_t)};
-        kb.emplace_back<assign_to_pyobject_kernel<ndt::fixed_dim_type>>(
-            kernreq, reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->dim_size,
-            reinterpret_cast<const size_stride_t *>(src_arrmeta[0])->stride);
+        const size_stride_t *ss = reinterpret_cast<const size_stride_t *>(src_arrmeta[0]);
+        kb.emplace_back<assign_to_pyobject_kernel<ndt::fixed_dim_type>>(kernreq, ss->dim_size, ss->stride,
+                                                                       contiguous_builtin_id(el_tp, ss->stride));
 
         kb(dynd::kernel_request_strided, nullptr, dst_arrmeta, 1, src_element_arrmeta);
       });
 
-      dynd::ndt::type src_element_tp[1] = {src_tp[0].extended<ndt::fixed_dim_type>()->get_element_type()};
-      dynd::nd::assign->resolve(this, nullptr, cg, dst_tp, nsrc, src_element_tp, nkwd, kwds, tp_vars);
+      dynd::nd::assign->resolve(this, data, cg, dst_tp, nsrc, src_element_tp, nkwd, kwds, tp_vars);
 
       return dst_tp;
     }
@@ -416,7 +449,7 @@ namespace nd {
     {
     }
 
-    ndt::type resolve(dynd::nd::base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data), dynd::nd::call_graph &cg,
+    ndt::type resolve(dynd::nd::base_callable *DYND_UNUSED(caller), char *data, dynd::nd::call_graph &cg,
                       const dynd::ndt::type &dst_tp, size_t nsrc, const dynd::ndt::type *src_tp, size_t nkwd,
                       const dynd::nd::array *kwds, const std::map<std::string, dynd::ndt::type> &tp_vars)
     {
@@ -424,16 +457,17 @@ namespace nd {
       cg.emplace_back([el_tp](dynd::nd::kernel_builder &kb, dynd::kernel_request_t kernreq, char *DYND_UNUSED(data),
                               const char *dst_arrmeta, size_t nsrc, const char *const *src_arrmeta) {
         intptr_t ckb_offset = kb.size();
-        kb.emplace_back<assign_to_pyobject_kernel<ndt::var_dim_type>>(
-            kernreq, reinterpret_cast<const dynd::ndt::var_dim_type::metadata_type *>(src_arrmeta[0])->offset,
-            reinterpret_cast<const dynd::ndt::var_dim_type::metadata_type *>(src_arrmeta[0])->stride);
+        const dynd::ndt::var_dim_type::metadata_type *md =
+            reinterpret_cast<const dynd::ndt::var_dim_type::metadata_type *>(src_arrmeta[0]);
+        kb.emplace_back<assign_to_pyobject_kernel<ndt::var_dim_type>>(kernreq, md->offset, md->stride,
+                                                                     contiguous_builtin_id(el_tp, md->stride));
 
         ckb_offset = kb.size();
         const char *el_arrmeta = src_arrmeta[0] + sizeof(dynd::ndt::var_dim_type::metadata_type);
         kb(dynd::kernel_request_strided, nullptr, dst_arrmeta, nsrc, &el_arrmeta);
       });
 
-      dynd::nd::assign->resolve(this, nullptr, cg, dst_tp, nsrc, &el_tp, nkwd, kwds, tp_vars);
+      dynd::nd::assign->resolve(this, data, cg, dst_tp, nsrc, &el_tp, nkwd, kwds, tp_vars);
 
       return dst_tp;
     }
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+
+#include <dynd/callables/base_callable.hpp>
+#include <dynd/callables/base_dispatch_callable.hpp>
+
+#include "kernels/numpy_ufunc.hpp"
+#include "types/pyobject_type.hpp"
+
+namespace pydynd {
+namespace nd {
+  namespace functional {
+
+    /**
+     * A callable for one inner loop of a NumPy ufunc, with the concrete signature of that loop.
+     */
+    template <bool gil>
+    class scalar_ufunc_callable : public dynd::nd::base_callable {
+      dynd::ndt::type m_dst_tp;
+      std::shared_ptr<scalar_ufunc_data> m_data;
+
+    public:
+      scalar_ufunc_callable(const dynd::ndt::type &dst_tp, const std::vector<dynd::ndt::type> &src_tp,
+                            std::shared_ptr<scalar_ufunc_data> data)
+          : dynd::nd::base_callable(dynd::ndt::make_type<dynd::ndt::callable_type>(dst_tp, src_tp)), m_dst_tp(dst_tp),
+            m_data(std::move(data))
+      {
+      }
+
+      dynd::ndt::type resolve(dynd::nd::base_callable *DYND_UNUSED(caller), char *DYND_UNUSED(data),
+                              dynd::nd::call_graph &cg, const dynd::ndt::type &DYND_UNUSED(dst_tp),
+                              size_t DYND_UNUSED(nsrc), const dynd::ndt::type *DYND_UNUSED(src_tp),
+                              size_t DYND_UNUSED(nkwd), const dynd::nd::array *DYND_UNUSED(kwds),
+                              const std::map<std::string, dynd::ndt::type> &DYND_UNUSED(tp_vars))
+      {
+        const scalar_ufunc_data *ufunc_data = m_data.get();
+        cg.emplace_back([ufunc_data](dynd::nd::kernel_builder &kb, dynd::kernel_request_t kernreq,
+                                     char *DYND_UNUSED(data), const char *DYND_UNUSED(dst_arrmeta),
+                                     size_t DYND_UNUSED(nsrc), const char *const *DYND_UNUSED(src_arrmeta)) {
+          kb.emplace_back<scalar_ufunc_ck<gil>>(kernreq, ufunc_data);
+        });
+
+        return m_dst_tp;
+      }
+    };
+
+    /**
+     * Dispatches to the inner loop of a NumPy ufunc whose input types match the argument
+     * types exactly. The callables for the loops are created the first time they are used.
+     */
+    class ufunc_dispatch_callable : public dynd::nd::base_dispatch_callable {
+      struct loop {
+        int index;
+        bool gil;
+        dynd::ndt::type dst_tp;
+        std::vector<dynd::ndt::type> src_tp;
+        dynd::nd::callable child;
+      };
+
+      PyUFuncObject *m_ufunc;
+      std::vector<loop> m_loops;
+
+      static dynd::ndt::type make_dispatch_type(intptr_t nsrc)
+      {
+        std::stringstream ss;
+        ss << "(";
+        for (intptr_t i = 0; i < nsrc; ++i) {
+          ss << (i == 0 ? "" : ", ") << "T" << i;
+        }
+        ss << ") -> R";
+        return dynd::ndt::type(ss.str());
+      }
+
+      static dynd::ndt::type loop_type(int type_num)
+      {
+        if (type_num == NPY_OBJECT) {
+          return dynd::ndt::make_type<pyobject_type>();
+        }
+
+        return _type_from_numpy_type_num(type_num);
+      }
+
+    public:
+      ufunc_dispatch_callable(PyUFuncObject *ufunc)
+          : dynd::nd::base_dispatch_callable(make_dispatch_type(ufunc->nin)), m_ufunc(ufunc)
+      {
+        Py_INCREF(m_ufunc);
+
+        // Keep the loops whose types all have a dynd equivalent, in the ufunc's order of preference
+        for (int i = 0; i < ufunc->ntypes; ++i) {
+          const char *types = ufunc->types + i * ufunc->nargs;
+          loop l;
+          l.index = i;
+          l.gil = false;
+          try {
+            for (int j = 0; j < ufunc->nin; ++j) {
+              l.src_tp.push_back(loop_type(types[j]));
+              l.gil |= types[j] == NPY_OBJECT;
+            }
+            l.dst_tp = loop_type(types[ufunc->nin]);
+            l.gil |= types[ufunc->nin] == NPY_OBJECT;
+          }
+          catch (const dynd::type_error &) {
+            continue;
+          }
+          m_loops.push_back(std::move(l));
+        }
+      }
+
+      ~ufunc_dispatch_callable()
+      {
+        PyGILState_RAII pgs;
+        Py_DECREF(m_ufunc);
+      }
+
+      const dynd::nd::callable &specialize(const dynd::ndt::type &DYND_UNUSED(dst_tp), intptr_t nsrc,
+                                           const dynd::ndt::type *src_tp)
+      {
+        for (loop &l : m_loops) {
+          if (!std::equal(l.src_tp.begin(), l.src_tp.end(), src_tp)) {
+            continue;
+          }
+
+          if (l.child.is_null()) {
+            auto data = std::make_shared<scalar_ufunc_data>(m_ufunc, m_ufunc->functions[l.index],
+                                                            m_ufunc->data[l.index], m_ufunc->nin);
+            if (l.gil) {
+              l.child = dynd::nd::make_callable<scalar_ufunc_callable<true>>(l.dst_tp, l.src_tp, std::move(data));
+            }
+            else {
+              l.child = dynd::nd::make_callable<scalar_ufunc_callable<false>>(l.dst_tp, l.src_tp, std::move(data));
+            }
+          }
+          return l.child;
+        }
+
+        std::stringstream ss;
+        ss << "NumPy ufunc '" << m_ufunc->name << "' has no loop for argument types (";
+        for (intptr_t i = 0; i < nsrc; ++i) {
+          ss << (i == 0 ? "" : ", ") << src_tp[i];
+        }
+        ss << ")";
+        throw dynd::type_error(ss.str());
+      }
+    };
+
+  } // namespace pydynd::nd::functional
+} // namespace pydynd::nd
+} // namespace pydynd
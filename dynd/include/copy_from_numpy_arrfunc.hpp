@@ -18,20 +18,18 @@ namespace nd {
 #ifdef DYND_NUMPY_INTEROP
 
   /**
-   * This is the arrmeta to provide for the source
-   * void type when instantiating the copy_from_numpy callable.
+   * Copies a numpy array into dynd array data. Element types which match
+   * the numpy dtype are copied as raw bytes, with dimensions that are
+   * contiguous in both arrays merged into a single memcpy and numpy
+   * struct fields copied straight into the matching dynd fields. Other
+   * elements, including numpy object arrays, go through dynd assignment.
+   *
+   * \param dst_tp  The destination type.
+   * \param dst_arrmeta  The destination arrmeta.
+   * \param dst_data  The destination data.
+   * \param src_arr  The numpy array to copy.
+   * \param ectx  The evaluation context.
    */
-  struct copy_from_numpy_arrmeta {
-    // This is the source PyArray_Descr *.
-    PyArray_Descr *src_dtype;
-    // This is the | together of the root data
-    // pointer and all the strides/offsets, and
-    // can be used to determine the minimum data alignment.
-    uintptr_t src_alignment;
-  };
-
-  extern dynd::nd::callable copy_from_numpy;
-
   void array_copy_from_numpy(const dynd::ndt::type &dst_tp, const char *dst_arrmeta, char *dst_data,
                              PyArrayObject *src_arr, const dynd::eval::eval_context *ectx);
 
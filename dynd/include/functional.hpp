@@ -12,3 +12,22 @@
 #include "visibility.hpp"
 
 PYDYND_API dynd::nd::callable apply(const dynd::ndt::type &tp, PyObject *func);
+
+/**
+ * Makes a callable which calls ``func`` once per chunk of up to ``chunk_size``
+ * elements, passing each argument as a one-dimensional view of the chunk and
+ * expecting an array of results back.
+ *
+ * \param tp  The callable type of a single element, with a concrete return type.
+ * \param func  The Python function.
+ * \param chunk_size  The largest number of elements passed in one call.
+ */
+PYDYND_API dynd::nd::callable apply_chunk(const dynd::ndt::type &tp, PyObject *func, intptr_t chunk_size);
+
+/**
+ * Makes an elementwise callable from the inner loops of a NumPy ufunc. Loops
+ * which don't operate on Python objects run without the GIL.
+ *
+ * \param ufunc  A NumPy ufunc with a single output and no core signature.
+ */
+PYDYND_API dynd::nd::callable from_ufunc(PyObject *ufunc);
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include <dynd/kernels/base_kernel.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+
+#include "array_from_py.hpp"
+#include "kernels/apply_pyobject_kernel.hpp"
+
+namespace pydynd {
+namespace nd {
+  namespace functional {
+
+    /**
+     * Calls a Python function once per chunk of up to ``chunk_size`` elements instead of once per
+     * element. The function receives each argument as a one-dimensional dynd view of the chunk,
+     * and returns an array of results, e.g. a NumPy array, which is assigned to the destination.
+     */
+    struct apply_pyobject_chunk_kernel : dynd::nd::base_strided_kernel<apply_pyobject_chunk_kernel> {
+      PyObject *m_pyfunc;
+      intptr_t m_chunk_size;
+      dynd::ndt::type m_dst_tp;
+      std::vector<dynd::ndt::type> m_src_tp;
+      const char *m_dst_arrmeta;
+      std::vector<const char *> m_src_arrmeta;
+
+      apply_pyobject_chunk_kernel(PyObject *pyfunc, intptr_t chunk_size, const dynd::ndt::type &dst_tp,
+                                  const std::vector<dynd::ndt::type> &src_tp, const char *dst_arrmeta,
+                                  const char *const *src_arrmeta)
+          : m_pyfunc(pyfunc), m_chunk_size(chunk_size), m_dst_tp(dst_tp), m_src_tp(src_tp), m_dst_arrmeta(dst_arrmeta),
+            m_src_arrmeta(src_arrmeta, src_arrmeta + src_tp.size())
+      {
+        Py_INCREF(m_pyfunc);
+      }
+
+      ~apply_pyobject_chunk_kernel()
+      {
+        pydynd::PyGILState_RAII pgs;
+        Py_DECREF(m_pyfunc);
+      }
+
+      /**
+       * Makes a one-dimensional array of ``size`` elements of type ``tp`` over memory owned by the caller.
+       */
+      static dynd::nd::array make_chunk(const dynd::ndt::type &tp, const char *arrmeta, char *data, intptr_t size,
+                                        intptr_t stride, uint32_t access_flags)
+      {
+        dynd::nd::array n = dynd::nd::make_array(dynd::ndt::make_fixed_dim(size, tp), data, access_flags);
+        dynd::fixed_dim_type_arrmeta *md = reinterpret_cast<dynd::fixed_dim_type_arrmeta *>(n.get()->metadata());
+        md->dim_size = size;
+        md->stride = stride;
+        if (tp.get_arrmeta_size() > 0) {
+          tp.extended()->arrmeta_copy_construct(n.get()->metadata() + sizeof(dynd::fixed_dim_type_arrmeta), arrmeta,
+                                                dynd::nd::memory_block());
+        }
+        return n;
+      }
+
+      void single(char *dst, char *const *src)
+      {
+        std::vector<intptr_t> src_stride(m_src_tp.size(), 0);
+        strided(dst, 0, src, src_stride.data(), 1);
+      }
+
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+      {
+        pydynd::PyGILState_RAII pgs;
+
+        intptr_t nsrc = m_src_tp.size();
+        for (size_t start = 0; start < count; start += m_chunk_size) {
+          intptr_t size = static_cast<intptr_t>(std::min<size_t>(count - start, m_chunk_size));
+
+          pydynd::pyobject_ownref args(PyTuple_New(nsrc));
+          for (intptr_t i = 0; i != nsrc; ++i) {
+            PyTuple_SET_ITEM(args.get(), i,
+                             pydynd::array_from_cpp(make_chunk(m_src_tp[i], m_src_arrmeta[i],
+                                                               src[i] + start * src_stride[i], size, src_stride[i],
+                                                               dynd::nd::read_access_flag)));
+          }
+
+          pydynd::pyobject_ownref res(PyObject_Call(m_pyfunc, args.get(), NULL));
+          {
+            dynd::nd::array res_array = pydynd::array_from_py(res.get(), 0, false);
+            if (res_array.get_ndim() == 0 || res_array.get_dim_size() != size) {
+              std::stringstream ss;
+              ss << "Python callback function " << pydynd::pyobject_repr(m_pyfunc) << " was called with " << size
+                 << " elements, but returned an array of type " << res_array.get_type() << " instead of " << size
+                 << " results";
+              throw std::invalid_argument(ss.str());
+            }
+            dynd::nd::array dst_chunk = make_chunk(m_dst_tp, m_dst_arrmeta, dst + start * dst_stride, size, dst_stride,
+                                                   dynd::nd::read_access_flag | dynd::nd::write_access_flag);
+            dst_chunk.assign(res_array);
+          }
+          res.clear();
+          // Validate that the call didn't hang onto the chunks, which is done after the dst
+          // assignment because the function result may have contained a reference to an argument
+          pydynd::verify_postcall_consistency(m_pyfunc, args.get());
+        }
+      }
+    };
+
+  } // namespace pydynd::nd::functional
+} // namespace pydynd::nd
+} // namespace pydynd
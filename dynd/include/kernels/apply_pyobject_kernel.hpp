@@ -7,6 +7,35 @@
 #include "type_functions.hpp"
 #include "types/pyobject_type.hpp"
 
+namespace pydynd {
+
+/**
+ * Verifies that a Python callback didn't keep a reference to any of the
+ * nd::array arguments in ``args``, which wrap temporary memory owned by the
+ * kernel calling it.
+ */
+inline void verify_postcall_consistency(PyObject *pyfunc, PyObject *args)
+{
+  intptr_t nsrc = PyTuple_GET_SIZE(args);
+  for (intptr_t i = 0; i != nsrc; ++i) {
+    PyObject *item = PyTuple_GET_ITEM(args, i);
+    if (Py_REFCNT(item) != 1 || array_to_cpp_ref(item)->get_use_count() != 1) {
+      std::stringstream ss;
+      ss << "Python callback function ";
+      pyobject_ownref pyfunc_repr(PyObject_Repr(pyfunc));
+      ss << pystring_as_string(pyfunc_repr.get());
+      ss << ", called by dynd, held a reference to parameter ";
+      ss << (i + 1) << " which contained temporary memory.";
+      ss << " This is disallowed.\n";
+      ss << "Python wrapper ref count: " << Py_REFCNT(item) << "\n";
+      array_to_cpp_ref(item).debug_print(ss);
+      throw std::runtime_error(ss.str());
+    }
+  }
+}
+
+} // namespace pydynd
+
 struct apply_pyobject_kernel : dynd::nd::base_strided_kernel<apply_pyobject_kernel> {
 
   // Reference to the python function object
@@ -28,27 +57,7 @@ struct apply_pyobject_kernel : dynd::nd::base_strided_kernel<apply_pyobject_kern
     }
   }
 
-  void verify_postcall_consistency(PyObject *args)
-  {
-    intptr_t nsrc = PyTuple_GET_SIZE(args);
-    // Verify that no reference to a temporary array was kept
-    for (intptr_t i = 0; i != nsrc; ++i) {
-      PyObject *item = PyTuple_GET_ITEM(args, i);
-      if (Py_REFCNT(item) != 1 || pydynd::array_to_cpp_ref(item)->get_use_count() != 1) {
-        std::stringstream ss;
-        ss << "Python callback function ";
-        pydynd::pyobject_ownref pyfunc_repr(PyObject_Repr(m_pyfunc));
-        ss << pydynd::pystring_as_string(pyfunc_repr.get());
-        ss << ", called by dynd, held a reference to parameter ";
-        ss << (i + 1) << " which contained temporary memory.";
-        ss << " This is disallowed.\n";
-        ss << "Python wrapper ref count: " << Py_REFCNT(item) << "\n";
-        pydynd::array_to_cpp_ref(item).debug_print(ss);
-        // Set all the args' data pointers to NULL as a precaution
-        throw std::runtime_error(ss.str());
-      }
-    }
-  }
+  void verify_postcall_consistency(PyObject *args) { pydynd::verify_postcall_consistency(m_pyfunc, args); }
 
   void call(dynd::nd::array *dst, const dynd::nd::array *src)
   {
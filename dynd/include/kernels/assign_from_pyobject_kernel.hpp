@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <cmath>
+#include <limits>
+
 #include <dynd/assignment.hpp>
 #include <dynd/kernels/base_kernel.hpp>
 #include <dynd/option.hpp>
@@ -51,11 +54,177 @@ namespace nd {
 
 namespace {
 
+#if DYND_NUMPY_INTEROP
+
+/**
+ * Converts a value read from a NumPy scalar to the kernel's destination type. Returns false
+ * when the conversion might lose information, leaving the error reporting to the checked
+ * assignment path.
+ */
+template <typename DstType, typename Enable = void>
+struct numpy_scalar_converter {
+  template <typename SrcType>
+  static bool convert(DstType &DYND_UNUSED(dst), SrcType DYND_UNUSED(src))
+  {
+    return false;
+  }
+};
+
+template <typename DstType>
+struct numpy_scalar_converter<DstType, std::enable_if_t<std::is_integral<DstType>::value>> {
+  template <typename SrcType>
+  static std::enable_if_t<std::is_integral<SrcType>::value, bool> convert(DstType &dst, SrcType src)
+  {
+    DstType value = static_cast<DstType>(src);
+    if (static_cast<SrcType>(value) != src || (value < 0) != (src < 0)) {
+      return false;
+    }
+    dst = value;
+    return true;
+  }
+
+  template <typename SrcType>
+  static std::enable_if_t<std::is_floating_point<SrcType>::value, bool> convert(DstType &DYND_UNUSED(dst),
+                                                                               SrcType DYND_UNUSED(src))
+  {
+    return false;
+  }
+};
+
+template <typename DstType>
+struct numpy_scalar_converter<DstType, std::enable_if_t<std::is_floating_point<DstType>::value>> {
+  template <typename SrcType>
+  static bool convert(DstType &dst, SrcType src)
+  {
+    if (std::is_floating_point<SrcType>::value && sizeof(SrcType) > sizeof(DstType) && std::isfinite(src) &&
+        std::fabs(src) > std::numeric_limits<DstType>::max()) {
+      return false;
+    }
+    dst = static_cast<DstType>(src);
+    return true;
+  }
+};
+
+template <typename T>
+struct numpy_scalar_converter<dynd::complex<T>> {
+  template <typename SrcType>
+  static bool convert(dynd::complex<T> &dst, SrcType src)
+  {
+    T real;
+    if (!numpy_scalar_converter<T>::convert(real, src)) {
+      return false;
+    }
+    dst = dynd::complex<T>(real, 0);
+    return true;
+  }
+};
+
+template <>
+struct numpy_scalar_converter<dynd::bool1> {
+  template <typename SrcType>
+  static bool convert(dynd::bool1 &dst, SrcType src)
+  {
+    if (!std::is_integral<SrcType>::value || (src != 0 && src != 1)) {
+      return false;
+    }
+    dst = dynd::bool1(src != 0);
+    return true;
+  }
+};
+
+/**
+ * Reads the value of a builtin NumPy scalar straight out of its ``obval``, so a list of NumPy
+ * scalars converts without creating an ``nd::array`` per element. Lists made by iterating over a
+ * NumPy array repeat the same scalar type, so the type number of the last exact NumPy scalar type
+ * seen is remembered. These types are static, so the pointer comparison is safe.
+ */
+class numpy_scalar_reader {
+  PyTypeObject *m_type = NULL;
+  int m_type_num = NPY_NOTYPE;
+
+  int type_num_of(PyObject *obj)
+  {
+    if (Py_TYPE(obj) == m_type) {
+      return m_type_num;
+    }
+    if (!PyArray_IsScalar(obj, Generic)) {
+      return NPY_NOTYPE;
+    }
+
+    PyArray_Descr *d = PyArray_DescrFromScalar(obj);
+    int type_num = d->type_num;
+    if (d->typeobj == Py_TYPE(obj)) {
+      m_type = Py_TYPE(obj);
+      m_type_num = type_num;
+    }
+    Py_DECREF(d);
+    return type_num;
+  }
+
+public:
+  /**
+   * Converts ``obj`` into ``dst`` if it is a NumPy boolean, integer or real floating point scalar
+   * whose value the destination type holds. Returns false without touching ``dst`` otherwise.
+   */
+  template <typename DstType>
+  bool read(PyObject *obj, DstType &dst)
+  {
+    typedef numpy_scalar_converter<DstType> converter;
+
+    switch (type_num_of(obj)) {
+    case NPY_BOOL:
+      // Passed as an int, since the sign checks of the integer conversion don't apply to bool
+      return converter::convert(dst, static_cast<int>(PyArrayScalar_VAL(obj, Bool) != 0));
+    case NPY_BYTE:
+      return converter::convert(dst, PyArrayScalar_VAL(obj, Byte));
+    case NPY_UBYTE:
+      return converter::convert(dst, PyArrayScalar_VAL(obj, UByte));
+    case NPY_SHORT:
+      return converter::convert(dst, PyArrayScalar_VAL(obj, Short));
+    case NPY_USHORT:
+      return converter::convert(dst, PyArrayScalar_VAL(obj, UShort));
+    case NPY_INT:
+      return converter::convert(dst, PyArrayScalar_VAL(obj, Int));
+    case NPY_UINT:
+      return converter::convert(dst, PyArrayScalar_VAL(obj, UInt));
+    case NPY_LONG:
+      return converter::convert(dst, PyArrayScalar_VAL(obj, Long));
+    case NPY_ULONG:
+      return converter::convert(dst, PyArrayScalar_VAL(obj, ULong));
+    case NPY_LONGLONG:
+      return converter::convert(dst, PyArrayScalar_VAL(obj, LongLong));
+    case NPY_ULONGLONG:
+      return converter::convert(dst, PyArrayScalar_VAL(obj, ULongLong));
+    case NPY_FLOAT:
+      return converter::convert(dst, PyArrayScalar_VAL(obj, Float));
+    case NPY_DOUBLE:
+      return converter::convert(dst, PyArrayScalar_VAL(obj, Double));
+    default:
+      return false;
+    }
+  }
+};
+
+#else
+
+class numpy_scalar_reader {
+public:
+  template <typename DstType>
+  bool read(PyObject *DYND_UNUSED(obj), DstType &DYND_UNUSED(dst))
+  {
+    return false;
+  }
+};
+
+#endif
+
 template <typename ReturnType, typename Enable = void>
 struct assign_from_pyobject_kernel;
 
 template <>
 struct assign_from_pyobject_kernel<bool> : nd::base_strided_kernel<assign_from_pyobject_kernel<bool>, 1> {
+  numpy_scalar_reader m_numpy_scalar;
+
   void single(char *dst, char *const *src)
   {
     PyObject *src_obj = *reinterpret_cast<PyObject **>(src[0]);
@@ -65,7 +234,7 @@ struct assign_from_pyobject_kernel<bool> : nd::base_strided_kernel<assign_from_p
     else if (src_obj == Py_False) {
       *dst = 0;
     }
-    else {
+    else if (!m_numpy_scalar.read(src_obj, *reinterpret_cast<dynd::bool1 *>(dst))) {
       *dst = pydynd::array_from_py(src_obj, 0, false).as<dynd::bool1>();
     }
   }
@@ -116,31 +285,7 @@ void pyint_to_int(int64_t *out, PyObject *obj)
   *out = static_cast<int64_t>(v);
 }
 
-void pyint_to_int(dynd::int128 *out, PyObject *obj)
-{
-#if PY_VERSION_HEX < 0x03000000
-  if (PyInt_Check(obj)) {
-    long value = PyInt_AS_LONG(obj);
-    *out = value;
-    return;
-  }
-#endif
-  uint64_t lo = PyLong_AsUnsignedLongLongMask(obj);
-  pydynd::pyobject_ownref sixtyfour(PyLong_FromLong(64));
-  pydynd::pyobject_ownref value_shr1(PyNumber_Rshift(obj, sixtyfour.get()));
-  uint64_t hi = PyLong_AsUnsignedLongLongMask(value_shr1.get());
-  dynd::int128 result(hi, lo);
-
-  // Shift right another 64 bits, and check that nothing is remaining
-  pydynd::pyobject_ownref value_shr2(PyNumber_Rshift(value_shr1.get(), sixtyfour.get()));
-  long remaining = PyLong_AsLong(value_shr2.get());
-  if ((remaining != 0 || (remaining == 0 && result.is_negative())) &&
-      (remaining != -1 || PyErr_Occurred() || (remaining == -1 && !result.is_negative()))) {
-    throw std::overflow_error("int is too big to fit in an int128");
-  }
-
-  *out = result;
-}
+void pyint_to_int(dynd::int128 *out, PyObject *obj) { *out = pydynd::pyint_as_int128(obj); }
 
 void pyint_to_int(uint8_t *out, PyObject *obj)
 {
@@ -228,6 +373,8 @@ void pyint_to_int(dynd::uint128 *out, PyObject *obj)
 template <typename ReturnType>
 struct assign_from_pyobject_kernel<ReturnType, std::enable_if_t<is_signed_integral<ReturnType>::value>>
     : dynd::nd::base_strided_kernel<assign_from_pyobject_kernel<ReturnType>, 1> {
+  numpy_scalar_reader m_numpy_scalar;
+
   void single(char *dst, char *const *src)
   {
     PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src[0]);
@@ -244,7 +391,9 @@ struct assign_from_pyobject_kernel<ReturnType, std::enable_if_t<is_signed_integr
           pydynd::array_from_numpy_array((PyArrayObject *)src_obj, 0, true).as<ReturnType>();
     }
     else if (PyArray_IsScalar(src_obj, Generic)) {
-      *reinterpret_cast<ReturnType *>(dst) = pydynd::array_from_numpy_scalar(src_obj, 0).as<ReturnType>();
+      if (!m_numpy_scalar.read(src_obj, *reinterpret_cast<ReturnType *>(dst))) {
+        *reinterpret_cast<ReturnType *>(dst) = pydynd::array_from_numpy_scalar(src_obj, 0).as<ReturnType>();
+      }
     }
 #endif
     else {
@@ -262,6 +411,8 @@ struct assign_from_pyobject_kernel<ReturnType, std::enable_if_t<is_signed_integr
 template <typename ReturnType>
 struct assign_from_pyobject_kernel<ReturnType, std::enable_if_t<is_unsigned_integral<ReturnType>::value>>
     : dynd::nd::base_strided_kernel<assign_from_pyobject_kernel<ReturnType>, 1> {
+  numpy_scalar_reader m_numpy_scalar;
+
   void single(char *dst, char *const *src)
   {
     PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src[0]);
@@ -272,7 +423,7 @@ struct assign_from_pyobject_kernel<ReturnType, std::enable_if_t<is_unsigned_inte
             ) {
       pyint_to_int(reinterpret_cast<ReturnType *>(dst), src_obj);
     }
-    else {
+    else if (!m_numpy_scalar.read(src_obj, *reinterpret_cast<ReturnType *>(dst))) {
       *reinterpret_cast<ReturnType *>(dst) = pydynd::array_from_py(src_obj, 0, false).as<ReturnType>();
     }
   }
@@ -281,6 +432,8 @@ struct assign_from_pyobject_kernel<ReturnType, std::enable_if_t<is_unsigned_inte
 template <typename ReturnType>
 struct assign_from_pyobject_kernel<ReturnType, std::enable_if_t<is_floating_point<ReturnType>::value>>
     : nd::base_strided_kernel<assign_from_pyobject_kernel<ReturnType>, 1> {
+  numpy_scalar_reader m_numpy_scalar;
+
   void single(char *dst, char *const *src)
   {
     PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src[0]);
@@ -291,7 +444,7 @@ struct assign_from_pyobject_kernel<ReturnType, std::enable_if_t<is_floating_poin
       }
       *reinterpret_cast<ReturnType *>(dst) = static_cast<ReturnType>(v);
     }
-    else {
+    else if (!m_numpy_scalar.read(src_obj, *reinterpret_cast<ReturnType *>(dst))) {
       *reinterpret_cast<ReturnType *>(dst) = pydynd::array_from_py(src_obj, 0, false).as<ReturnType>();
     }
   }
@@ -303,6 +456,8 @@ struct assign_from_pyobject_kernel<ReturnType, std::enable_if_t<is_complex<Retur
   typedef ReturnType U;
   typedef typename U::value_type T;
 
+  numpy_scalar_reader m_numpy_scalar;
+
   void single(char *dst, char *const *src)
   {
     PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src[0]);
@@ -314,7 +469,7 @@ struct assign_from_pyobject_kernel<ReturnType, std::enable_if_t<is_complex<Retur
       reinterpret_cast<T *>(dst)[0] = static_cast<T>(v.real);
       reinterpret_cast<T *>(dst)[1] = static_cast<T>(v.imag);
     }
-    else {
+    else if (!m_numpy_scalar.read(src_obj, *reinterpret_cast<dynd::complex<T> *>(dst))) {
       *reinterpret_cast<dynd::complex<T> *>(dst) = pydynd::array_from_py(src_obj, 0, false).as<dynd::complex<T>>();
     }
   }
@@ -376,6 +531,16 @@ struct assign_from_pyobject_kernel<dynd::string>
   {
     PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src[0]);
 
+#if PY_VERSION_HEX >= 0x03030000
+    if (dst_tp.get_id() == dynd::string_id && PyUnicode_Check(src_obj)) {
+      // Copy the UTF-8 data straight into the destination string
+      Py_ssize_t len = 0;
+      const char *s = pydynd::pyunicode_as_utf8(src_obj, len);
+      reinterpret_cast<dynd::string *>(dst)->assign(s, len);
+      return;
+    }
+#endif
+
     char *pybytes_data = NULL;
     intptr_t pybytes_len = 0;
     if (PyUnicode_Check(src_obj)) {
@@ -418,6 +583,38 @@ struct assign_from_pyobject_kernel<dynd::string>
       throw std::invalid_argument(ss.str());
     }
   }
+
+  void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+  {
+#if PY_VERSION_HEX >= 0x03030000
+    if (dst_tp.get_id() == dynd::string_id) {
+      // Size all the UTF-8 payloads first, so that a non-str item or an
+      // encoding error is found before any destination string is touched
+      std::vector<std::pair<const char *, Py_ssize_t>> payloads(count);
+      char *src0 = src[0];
+      bool all_str = true;
+      for (size_t i = 0; i != count; ++i, src0 += src_stride[0]) {
+        PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src0);
+        if (!PyUnicode_Check(src_obj)) {
+          all_str = false;
+          break;
+        }
+        payloads[i].first = pydynd::pyunicode_as_utf8(src_obj, payloads[i].second);
+      }
+      if (all_str) {
+        for (size_t i = 0; i != count; ++i, dst += dst_stride) {
+          reinterpret_cast<dynd::string *>(dst)->assign(payloads[i].first, payloads[i].second);
+        }
+        return;
+      }
+    }
+#endif
+
+    char *src0 = src[0];
+    for (size_t i = 0; i != count; ++i, dst += dst_stride, src0 += src_stride[0]) {
+      single(dst, &src0);
+    }
+  }
 };
 
 template <>
@@ -434,6 +631,18 @@ struct assign_from_pyobject_kernel<dynd::ndt::type>
   }
 };
 
+template <>
+struct assign_from_pyobject_kernel<pyobject_type>
+    : dynd::nd::base_strided_kernel<assign_from_pyobject_kernel<pyobject_type>, 1> {
+  void single(char *dst, char *const *src)
+  {
+    PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src[0]);
+    Py_XINCREF(src_obj);
+    Py_XDECREF(*reinterpret_cast<PyObject **>(dst));
+    *reinterpret_cast<PyObject **>(dst) = src_obj;
+  }
+};
+
 template <>
 struct assign_from_pyobject_kernel<dynd::ndt::option_type>
     : nd::base_strided_kernel<assign_from_pyobject_kernel<dynd::ndt::option_type>, 1> {
@@ -452,13 +661,33 @@ struct assign_from_pyobject_kernel<dynd::ndt::option_type>
     get_child(copy_value_offset)->destroy();
   }
 
+  /**
+   * Whether ``src_obj`` is converted by the copy_value child, rather than
+   * being None or one of the special cases handled in single().
+   */
+  bool is_plain_value(PyObject *src_obj) const
+  {
+    if (src_obj == Py_None || PyObject_TypeCheck(src_obj, pydynd::get_array_pytypeobject())) {
+      return false;
+    }
+    if (dst_tp.get_base_id() != dynd::string_kind_id) {
+#if PY_VERSION_HEX < 0x03000000
+      if (PyString_Check(src_obj)) {
+        return false;
+      }
+#endif
+      return !PyUnicode_Check(src_obj);
+    }
+    return true;
+  }
+
   void single(char *dst, char *const *src)
   {
     PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src[0]);
     if (src_obj == Py_None) {
       nd::kernel_prefix *assign_na = get_child();
-      dynd::kernel_single_t assign_na_fn = assign_na->get_function<dynd::kernel_single_t>();
-      assign_na_fn(assign_na, dst, NULL);
+      dynd::kernel_strided_t assign_na_fn = assign_na->get_function<dynd::kernel_strided_t>();
+      assign_na_fn(assign_na, dst, 0, NULL, NULL, 1);
     }
     else if (PyObject_TypeCheck(src_obj, pydynd::get_array_pytypeobject())) {
       pydynd::nd::typed_data_assign(dst_tp, dst_arrmeta, dst, pydynd::array_to_cpp_ref(src_obj));
@@ -496,13 +725,135 @@ struct assign_from_pyobject_kernel<dynd::ndt::option_type>
     }
     else {
       nd::kernel_prefix *copy_value = get_child(copy_value_offset);
-      dynd::kernel_single_t copy_value_fn = copy_value->get_function<dynd::kernel_single_t>();
-      copy_value_fn(copy_value, dst, src);
+      dynd::kernel_strided_t copy_value_fn = copy_value->get_function<dynd::kernel_strided_t>();
+      intptr_t src_stride = 0;
+      copy_value_fn(copy_value, dst, 0, src, &src_stride, 1);
+    }
+  }
+
+  void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+  {
+    // Runs of None are assigned NA, and runs of plain values are converted,
+    // with one strided call per run rather than a child call per element
+    nd::kernel_prefix *assign_na = get_child();
+    dynd::kernel_strided_t assign_na_fn = assign_na->get_function<dynd::kernel_strided_t>();
+    nd::kernel_prefix *copy_value = get_child(copy_value_offset);
+    dynd::kernel_strided_t copy_value_fn = copy_value->get_function<dynd::kernel_strided_t>();
+
+    intptr_t src0_stride = src_stride[0];
+    auto obj_at = [&](size_t j) { return *reinterpret_cast<PyObject *const *>(src[0] + j * src0_stride); };
+    size_t i = 0;
+    while (i < count) {
+      char *run_src = src[0] + i * src0_stride;
+      char *run_dst = dst + i * dst_stride;
+      PyObject *src_obj = obj_at(i);
+      size_t run_end = i + 1;
+      if (src_obj == Py_None) {
+        while (run_end < count && obj_at(run_end) == Py_None) {
+          ++run_end;
+        }
+        assign_na_fn(assign_na, run_dst, dst_stride, NULL, NULL, run_end - i);
+      }
+      else if (is_plain_value(src_obj)) {
+        while (run_end < count && is_plain_value(obj_at(run_end))) {
+          ++run_end;
+        }
+        copy_value_fn(copy_value, run_dst, dst_stride, &run_src, &src0_stride, run_end - i);
+      }
+      else {
+        single(run_dst, &run_src);
+      }
+      i = run_end;
     }
   }
 };
 
-// TODO: Should make a more efficient strided kernel function
+// Number of rows whose field values are gathered into the column buffer
+// before each field's kernel is run over them
+static const size_t record_ingest_chunk_rows = 256;
+
+/**
+ * Runs each field's strided child kernel once over ``nrows`` rows, whose
+ * field values were gathered into ``columns`` as ``field_count`` columns
+ * of ``record_ingest_chunk_rows`` PyObject pointers each.
+ */
+template <typename SelfType>
+void assign_record_columns(SelfType *self, char *dst, intptr_t dst_stride, PyObject **columns, size_t nrows)
+{
+  const uintptr_t *field_offsets = reinterpret_cast<const uintptr_t *>(self->m_dst_arrmeta);
+  intptr_t column_stride = sizeof(PyObject *);
+  for (size_t i = 0; i < self->m_copy_el_offsets.size(); ++i) {
+    nd::kernel_prefix *copy_el = self->get_child(self->m_copy_el_offsets[i]);
+    dynd::kernel_strided_t copy_el_fn = copy_el->get_function<dynd::kernel_strided_t>();
+    char *el_src = reinterpret_cast<char *>(columns + i * record_ingest_chunk_rows);
+    copy_el_fn(copy_el, dst + field_offsets[i], dst_stride, &el_src, &column_stride, nrows);
+  }
+  if (PyErr_Occurred()) {
+    throw std::exception();
+  }
+}
+
+/**
+ * Gathers the fields of an exact list or tuple row into column ``row`` of
+ * the column buffer, returning false if the row needs the general path.
+ */
+inline bool gather_record_sequence(PyObject *row_obj, intptr_t field_count, PyObject **columns, size_t row)
+{
+  if (!PyTuple_CheckExact(row_obj) && !PyList_CheckExact(row_obj)) {
+    return false;
+  }
+  if (PySequence_Fast_GET_SIZE(row_obj) != field_count) {
+    return false;
+  }
+  PyObject **items = PySequence_Fast_ITEMS(row_obj);
+  for (intptr_t i = 0; i < field_count; ++i) {
+    columns[i * record_ingest_chunk_rows + row] = items[i];
+  }
+  return true;
+}
+
+/**
+ * The strided loop of the tuple and struct kernels. Rows are walked once, with
+ * the field values of list and tuple rows, and of any row ``gather_other(row_obj,
+ * columns, row)`` accepts, gathered into the column buffer and assigned a chunk
+ * at a time. Each field's kernel is then dispatched once per chunk instead of
+ * once per row. Any other row flushes what has been gathered and goes through
+ * ``self->single``.
+ */
+template <typename SelfType, typename GatherType>
+void assign_records_strided(SelfType *self, char *dst, intptr_t dst_stride, char *src0, intptr_t src0_stride,
+                            size_t count, GatherType gather_other)
+{
+  intptr_t field_count = self->m_copy_el_offsets.size();
+  self->m_columns.resize(field_count * record_ingest_chunk_rows);
+  PyObject **columns = self->m_columns.data();
+
+  char *chunk_dst = dst;
+  size_t nrows = 0;
+  for (size_t i = 0; i != count; ++i, src0 += src0_stride) {
+    PyObject *row_obj = *reinterpret_cast<PyObject *const *>(src0);
+    // A row which single() would broadcast as a scalar isn't gathered as a sequence
+    bool broadcast = self->m_dim_broadcast && pydynd::broadcast_as_scalar(self->m_dst_tp, row_obj);
+    if ((!broadcast && gather_record_sequence(row_obj, field_count, columns, nrows)) ||
+        gather_other(row_obj, columns, nrows)) {
+      if (++nrows == record_ingest_chunk_rows) {
+        assign_record_columns(self, chunk_dst, dst_stride, columns, nrows);
+        chunk_dst += nrows * dst_stride;
+        nrows = 0;
+      }
+      continue;
+    }
+
+    // Flush what has been gathered, then take the general path for this row
+    assign_record_columns(self, chunk_dst, dst_stride, columns, nrows);
+    chunk_dst += nrows * dst_stride;
+    nrows = 0;
+    self->single(chunk_dst, &src0);
+    chunk_dst += dst_stride;
+  }
+  assign_record_columns(self, chunk_dst, dst_stride, columns, nrows);
+}
+
 template <>
 struct assign_from_pyobject_kernel<dynd::ndt::tuple_type>
     : dynd::nd::base_strided_kernel<assign_from_pyobject_kernel<dynd::ndt::tuple_type>, 1> {
@@ -511,6 +862,9 @@ struct assign_from_pyobject_kernel<dynd::ndt::tuple_type>
   bool m_dim_broadcast;
   std::vector<intptr_t> m_copy_el_offsets;
 
+  // Field values gathered column by column, see assign_record_columns
+  std::vector<PyObject *> m_columns;
+
   ~assign_from_pyobject_kernel()
   {
     for (size_t i = 0; i < m_copy_el_offsets.size(); ++i) {
@@ -563,18 +917,23 @@ struct assign_from_pyobject_kernel<dynd::ndt::tuple_type>
     }
     for (intptr_t i = 0; i < field_count; ++i) {
       nd::kernel_prefix *copy_el = get_child(m_copy_el_offsets[i]);
-      dynd::kernel_single_t copy_el_fn = copy_el->get_function<dynd::kernel_single_t>();
-      char *el_dst = dst + field_offsets[i];
+      dynd::kernel_strided_t copy_el_fn = copy_el->get_function<dynd::kernel_strided_t>();
       char *el_src = child_src + i * child_stride;
-      copy_el_fn(copy_el, el_dst, &el_src);
+      copy_el_fn(copy_el, dst + field_offsets[i], 0, &el_src, &child_stride, 1);
     }
     if (PyErr_Occurred()) {
       throw std::exception();
     }
   }
+
+  void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+  {
+    assign_records_strided(this, dst, dst_stride, src[0], src_stride[0], count,
+                           [](PyObject *DYND_UNUSED(row_obj), PyObject **DYND_UNUSED(columns),
+                              size_t DYND_UNUSED(row)) { return false; });
+  }
 };
 
-// TODO: Should make a more efficient strided kernel function
 template <>
 struct assign_from_pyobject_kernel<dynd::ndt::struct_type>
     : dynd::nd::base_strided_kernel<assign_from_pyobject_kernel<dynd::ndt::struct_type>, 1> {
@@ -583,13 +942,119 @@ struct assign_from_pyobject_kernel<dynd::ndt::struct_type>
   bool m_dim_broadcast;
   std::vector<intptr_t> m_copy_el_offsets;
 
+  // Field values gathered column by column, see assign_record_columns
+  std::vector<PyObject *> m_columns;
+  // Interned field names as Python strings and their hashes, built by init_field_names
+  std::vector<PyObject *> m_field_names;
+  std::vector<Py_ssize_t> m_field_hashes;
+  // Open addressing tables of field indices, placed by the address of the field name
+  // and by its hash, with -1 in the empty slots. They are at least twice the field count.
+  std::vector<intptr_t> m_address_table;
+  std::vector<intptr_t> m_hash_table;
+  size_t m_table_mask;
+
+  assign_from_pyobject_kernel(const dynd::ndt::type &dst_tp, const char *dst_arrmeta, bool dim_broadcast)
+      : m_dst_tp(dst_tp), m_dst_arrmeta(dst_arrmeta), m_dim_broadcast(dim_broadcast)
+  {
+    init_field_names();
+  }
+
   ~assign_from_pyobject_kernel()
   {
+    for (size_t i = 0; i < m_field_names.size(); ++i) {
+      Py_XDECREF(m_field_names[i]);
+    }
     for (size_t i = 0; i < m_copy_el_offsets.size(); ++i) {
       get_child(m_copy_el_offsets[i])->destroy();
     }
   }
 
+  static size_t address_slot(PyObject *key) { return reinterpret_cast<uintptr_t>(key) >> 4; }
+
+  /**
+   * Creates the interned Python strings for the field names of m_dst_tp,
+   * along with their hashes and the lookup tables for lookup_field_index.
+   */
+  void init_field_names()
+  {
+    const dynd::ndt::struct_type *sd = m_dst_tp.extended<dynd::ndt::struct_type>();
+    intptr_t field_count = sd->get_field_count();
+    m_field_names.resize(field_count, NULL);
+    m_field_hashes.resize(field_count);
+    for (intptr_t i = 0; i < field_count; ++i) {
+      const dynd::string &fn = sd->get_field_name(i);
+#if PY_VERSION_HEX >= 0x03000000
+      m_field_names[i] = PyUnicode_FromStringAndSize(fn.begin(), fn.end() - fn.begin());
+      if (m_field_names[i] != NULL) {
+        PyUnicode_InternInPlace(&m_field_names[i]);
+      }
+#else
+      m_field_names[i] = PyString_FromStringAndSize(fn.begin(), fn.end() - fn.begin());
+      if (m_field_names[i] != NULL) {
+        PyString_InternInPlace(&m_field_names[i]);
+      }
+#endif
+      if (m_field_names[i] == NULL) {
+        throw std::exception();
+      }
+      m_field_hashes[i] = PyObject_Hash(m_field_names[i]);
+    }
+
+    size_t table_size = 4;
+    while (table_size < 2 * static_cast<size_t>(field_count)) {
+      table_size *= 2;
+    }
+    m_table_mask = table_size - 1;
+    m_address_table.assign(table_size, -1);
+    m_hash_table.assign(table_size, -1);
+    for (intptr_t i = 0; i < field_count; ++i) {
+      size_t slot = address_slot(m_field_names[i]) & m_table_mask;
+      while (m_address_table[slot] >= 0) {
+        slot = (slot + 1) & m_table_mask;
+      }
+      m_address_table[slot] = i;
+      slot = static_cast<size_t>(m_field_hashes[i]) & m_table_mask;
+      while (m_hash_table[slot] >= 0) {
+        slot = (slot + 1) & m_table_mask;
+      }
+      m_hash_table[slot] = i;
+    }
+  }
+
+  /**
+   * Returns the index of the field named by the dict key ``key``, or -1
+   * if there is no such field. Keys which are the interned field names are
+   * found by address, and any other key by hash and equality.
+   */
+  intptr_t lookup_field_index(PyObject *key)
+  {
+    for (size_t slot = address_slot(key) & m_table_mask; m_address_table[slot] >= 0;
+         slot = (slot + 1) & m_table_mask) {
+      if (m_field_names[m_address_table[slot]] == key) {
+        return m_address_table[slot];
+      }
+    }
+
+    Py_ssize_t hash = PyObject_Hash(key);
+    if (hash == -1) {
+      throw std::exception();
+    }
+    for (size_t slot = static_cast<size_t>(hash) & m_table_mask; m_hash_table[slot] >= 0;
+         slot = (slot + 1) & m_table_mask) {
+      intptr_t i = m_hash_table[slot];
+      if (m_field_hashes[i] == hash) {
+        int eq = PyObject_RichCompareBool(key, m_field_names[i], Py_EQ);
+        if (eq < 0) {
+          throw std::exception();
+        }
+        if (eq) {
+          return i;
+        }
+      }
+    }
+    return -1;
+  }
+
   void single(char *dst, char *const *src)
   {
     PyObject *src_obj = *reinterpret_cast<PyObject *const *>(src[0]);
@@ -619,22 +1084,21 @@ struct assign_from_pyobject_kernel<dynd::ndt::struct_type>
       Py_ssize_t dict_pos = 0;
 
       while (PyDict_Next(src_obj, &dict_pos, &dict_key, &dict_value)) {
-        std::string name = pydynd::pystring_as_string(dict_key);
-        intptr_t i = m_dst_tp.extended<dynd::ndt::struct_type>()->get_field_index(name);
+        intptr_t i = lookup_field_index(dict_key);
         // TODO: Add an error policy of whether to throw an error
         //       or not. For now, just raise an error
         if (i >= 0) {
           nd::kernel_prefix *copy_el = get_child(m_copy_el_offsets[i]);
-          dynd::kernel_single_t copy_el_fn = copy_el->get_function<dynd::kernel_single_t>();
-          char *el_dst = dst + field_offsets[i];
+          dynd::kernel_strided_t copy_el_fn = copy_el->get_function<dynd::kernel_strided_t>();
           char *el_src = reinterpret_cast<char *>(&dict_value);
-          copy_el_fn(copy_el, el_dst, &el_src);
+          intptr_t el_src_stride = 0;
+          copy_el_fn(copy_el, dst + field_offsets[i], 0, &el_src, &el_src_stride, 1);
           populated_fields[i] = true;
         }
         else {
           std::stringstream ss;
           ss << "Input python dict has key ";
-          dynd::print_escaped_utf8_string(ss, name);
+          dynd::print_escaped_utf8_string(ss, pydynd::pystring_as_string(dict_key));
           ss << ", but no such field is in destination dynd type " << m_dst_tp;
           throw dynd::broadcast_error(ss.str());
         }
@@ -676,16 +1140,44 @@ struct assign_from_pyobject_kernel<dynd::ndt::struct_type>
       }
       for (intptr_t i = 0; i < field_count; ++i) {
         nd::kernel_prefix *copy_el = get_child(m_copy_el_offsets[i]);
-        dynd::kernel_single_t copy_el_fn = copy_el->get_function<dynd::kernel_single_t>();
-        char *el_dst = dst + field_offsets[i];
+        dynd::kernel_strided_t copy_el_fn = copy_el->get_function<dynd::kernel_strided_t>();
         char *el_src = child_src + i * child_stride;
-        copy_el_fn(copy_el, el_dst, &el_src);
+        copy_el_fn(copy_el, dst + field_offsets[i], 0, &el_src, &child_stride, 1);
       }
     }
     if (PyErr_Occurred()) {
       throw std::exception();
     }
   }
+
+  /**
+   * Gathers the fields of an exact dict row into column ``row`` of the
+   * column buffer, returning false if the row needs the general path.
+   */
+  bool gather_dict(PyObject *row_obj, PyObject **columns, size_t row)
+  {
+    intptr_t field_count = m_field_names.size();
+    if (!PyDict_CheckExact(row_obj) || PyDict_Size(row_obj) != field_count) {
+      return false;
+    }
+    // With every field found and the sizes equal, there are no extra keys
+    for (intptr_t i = 0; i < field_count; ++i) {
+      PyObject *value = PyDict_GetItem(row_obj, m_field_names[i]);
+      if (value == NULL) {
+        return false;
+      }
+      columns[i * record_ingest_chunk_rows + row] = value;
+    }
+    return true;
+  }
+
+  void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+  {
+    assign_records_strided(this, dst, dst_stride, src[0], src_stride[0], count,
+                           [this](PyObject *row_obj, PyObject **columns, size_t row) {
+                             return gather_dict(row_obj, columns, row);
+                           });
+  }
 };
 
 // TODO: Could create the dst_tp -> dst_tp assignment
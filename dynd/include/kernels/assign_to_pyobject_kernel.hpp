@@ -5,8 +5,14 @@
 
 #pragma once
 
+#include <sstream>
+
+#include <dynd/types/categorical_kind_type.hpp>
+#include <dynd/types/categorical_type.hpp>
 #include <dynd/types/fixed_bytes_type.hpp>
 
+#include "assign.hpp"
+
 using namespace dynd;
 
 template <typename Arg0Type, typename Enable = void>
@@ -243,28 +249,95 @@ struct assign_to_pyobject_kernel<char> : dynd::nd::base_strided_kernel<assign_to
   }
 };
 
-struct string_ascii_assign_kernel : dynd::nd::base_strided_kernel<string_ascii_assign_kernel, 1> {
+/**
+ * Returns true if all the bytes in [begin, end) are 7-bit ASCII, testing
+ * the high bits a machine word at a time.
+ */
+inline bool is_ascii_bytes(const char *begin, const char *end)
+{
+  const size_t high_bits = static_cast<size_t>(0x8080808080808080ULL);
+  for (; end - begin >= static_cast<intptr_t>(sizeof(size_t)); begin += sizeof(size_t)) {
+    size_t word;
+    memcpy(&word, begin, sizeof(size_t));
+    if (word & high_bits) {
+      return false;
+    }
+  }
+  for (; begin != end; ++begin) {
+    if (*begin & 0x80) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Creates a Python unicode string from ASCII or UTF-8 encoded bytes. Pure
+ * ASCII values are copied straight into a compact string, and only the
+ * rest go through the codec, which also raises for invalid input.
+ *
+ * \param begin  The start of the encoded bytes.
+ * \param end  One past the end of the encoded bytes.
+ * \param encoding  Either string_encoding_ascii or string_encoding_utf_8.
+ */
+inline PyObject *pyunicode_from_ascii_or_utf8(const char *begin, const char *end, dynd::string_encoding_t encoding)
+{
+  PyObject *res;
+#if PY_VERSION_HEX >= 0x03030000
+  if (is_ascii_bytes(begin, end)) {
+    res = PyUnicode_New(end - begin, 127);
+    if (res == NULL) {
+      throw std::exception();
+    }
+    memcpy(PyUnicode_1BYTE_DATA(res), begin, end - begin);
+    return res;
+  }
+#endif
+  if (encoding == dynd::string_encoding_ascii) {
+    res = PyUnicode_DecodeASCII(begin, end - begin, NULL);
+  }
+  else {
+    res = PyUnicode_DecodeUTF8(begin, end - begin, NULL);
+  }
+  if (res == NULL) {
+    throw std::exception();
+  }
+  return res;
+}
+
+/**
+ * Kernel exporting ASCII or UTF-8 dynd strings. The strided function
+ * converts a whole column in one loop rather than one single() per element.
+ */
+template <dynd::string_encoding_t Encoding>
+struct string_ascii_or_utf8_assign_kernel
+    : dynd::nd::base_strided_kernel<string_ascii_or_utf8_assign_kernel<Encoding>, 1> {
   void single(char *dst, char *const *src)
   {
     PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
     Py_XDECREF(*dst_obj);
     *dst_obj = NULL;
     const dynd::string *sd = reinterpret_cast<const dynd::string *>(src[0]);
-    *dst_obj = PyUnicode_DecodeASCII(sd->begin(), sd->end() - sd->begin(), NULL);
+    *dst_obj = pyunicode_from_ascii_or_utf8(sd->begin(), sd->end(), Encoding);
   }
-};
 
-struct string_utf8_assign_kernel : dynd::nd::base_strided_kernel<string_utf8_assign_kernel, 1> {
-  void single(char *dst, char *const *src)
+  void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
   {
-    PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
-    Py_XDECREF(*dst_obj);
-    *dst_obj = NULL;
-    const dynd::string *sd = reinterpret_cast<const dynd::string *>(src[0]);
-    *dst_obj = PyUnicode_DecodeUTF8(sd->begin(), sd->end() - sd->begin(), NULL);
+    const char *src0 = src[0];
+    intptr_t src0_stride = src_stride[0];
+    for (size_t i = 0; i != count; ++i, dst += dst_stride, src0 += src0_stride) {
+      PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
+      Py_XDECREF(*dst_obj);
+      *dst_obj = NULL;
+      const dynd::string *sd = reinterpret_cast<const dynd::string *>(src0);
+      *dst_obj = pyunicode_from_ascii_or_utf8(sd->begin(), sd->end(), Encoding);
+    }
   }
 };
 
+typedef string_ascii_or_utf8_assign_kernel<dynd::string_encoding_ascii> string_ascii_assign_kernel;
+typedef string_ascii_or_utf8_assign_kernel<dynd::string_encoding_utf_8> string_utf8_assign_kernel;
+
 struct string_utf16_assign_kernel : dynd::nd::base_strided_kernel<string_utf16_assign_kernel, 1> {
   void single(char *dst, char *const *src)
   {
@@ -297,8 +370,8 @@ struct fixed_string_ascii_assign_kernel : dynd::nd::base_strided_kernel<fixed_st
     PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
     Py_XDECREF(*dst_obj);
     *dst_obj = NULL;
-    intptr_t size = std::find(src[0], src[0] + data_size, 0) - src[0];
-    *dst_obj = PyUnicode_DecodeASCII(src[0], size, NULL);
+    *dst_obj = pyunicode_from_ascii_or_utf8(src[0], std::find(src[0], src[0] + data_size, 0),
+                                            dynd::string_encoding_ascii);
   }
 };
 
@@ -312,8 +385,8 @@ struct fixed_string_utf8_assign_kernel : dynd::nd::base_strided_kernel<fixed_str
     PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
     Py_XDECREF(*dst_obj);
     *dst_obj = NULL;
-    intptr_t size = std::find(src[0], src[0] + data_size, 0) - src[0];
-    *dst_obj = PyUnicode_DecodeUTF8(src[0], size, NULL);
+    *dst_obj = pyunicode_from_ascii_or_utf8(src[0], std::find(src[0], src[0] + data_size, 0),
+                                            dynd::string_encoding_utf_8);
   }
 };
 
@@ -349,7 +422,10 @@ struct fixed_string_utf32_assign_kernel : dynd::nd::base_strided_kernel<fixed_st
   }
 };
 
-// TODO: Should make a more efficient strided kernel function
+// Number of elements whose NA flags are computed together before their
+// valid values are converted
+static const size_t option_export_chunk_size = 256;
+
 template <>
 struct assign_to_pyobject_kernel<ndt::option_type>
     : dynd::nd::base_strided_kernel<assign_to_pyobject_kernel<ndt::option_type>, 1> {
@@ -363,22 +439,95 @@ struct assign_to_pyobject_kernel<ndt::option_type>
 
   void single(char *dst, char *const *src)
   {
-    PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
-    Py_XDECREF(*dst_obj);
-    *dst_obj = NULL;
+    intptr_t src_stride = 0;
+    strided(dst, 0, src, &src_stride, 1);
+  }
+
+  void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
+  {
     dynd::nd::kernel_prefix *is_na = get_child();
-    dynd::kernel_single_t is_na_fn = is_na->get_function<dynd::kernel_single_t>();
+    dynd::kernel_strided_t is_na_fn = is_na->get_function<dynd::kernel_strided_t>();
     dynd::nd::kernel_prefix *assign_value = get_child(m_assign_value_offset);
-    dynd::kernel_single_t assign_value_fn = assign_value->get_function<dynd::kernel_single_t>();
-    char value_is_na = 1;
-    is_na_fn(is_na, &value_is_na, src);
-    if (value_is_na == 0) {
-      assign_value_fn(assign_value, dst, src);
+    dynd::kernel_strided_t assign_value_fn = assign_value->get_function<dynd::kernel_strided_t>();
+
+    // The NA mask of a chunk is computed first, then each run of valid
+    // values is converted with a single strided call
+    char value_is_na[option_export_chunk_size];
+    intptr_t mask_stride = 1;
+    char *src0 = src[0];
+    intptr_t src0_stride = src_stride[0];
+    while (count > 0) {
+      size_t chunk_size = std::min(count, option_export_chunk_size);
+      is_na_fn(is_na, value_is_na, mask_stride, &src0, &src0_stride, chunk_size);
+      for (size_t i = 0; i < chunk_size;) {
+        size_t run_end = i + 1;
+        while (run_end < chunk_size && (value_is_na[run_end] != 0) == (value_is_na[i] != 0)) {
+          ++run_end;
+        }
+        if (value_is_na[i] == 0) {
+          char *run_src = src0 + i * src0_stride;
+          assign_value_fn(assign_value, dst + i * dst_stride, dst_stride, &run_src, &src0_stride, run_end - i);
+        }
+        else {
+          for (size_t j = i; j < run_end; ++j) {
+            PyObject **dst_obj = reinterpret_cast<PyObject **>(dst + j * dst_stride);
+            Py_XDECREF(*dst_obj);
+            *dst_obj = Py_None;
+            Py_INCREF(Py_None);
+          }
+        }
+        i = run_end;
+      }
+      dst += chunk_size * dst_stride;
+      src0 += chunk_size * src0_stride;
+      count -= chunk_size;
     }
-    else {
-      *dst_obj = Py_None;
-      Py_INCREF(*dst_obj);
+  }
+};
+
+template <>
+struct assign_to_pyobject_kernel<ndt::categorical_type>
+    : dynd::nd::base_strided_kernel<assign_to_pyobject_kernel<ndt::categorical_type>, 1> {
+  // A list with the Python object of each category, indexed by its storage value
+  pydynd::pyobject_ownref m_values;
+  size_t m_storage_size;
+
+  /**
+   * Converts the categories of ``src_tp`` to Python objects once, so each element is exported
+   * as a new reference to the object of its category.
+   */
+  assign_to_pyobject_kernel(const dynd::ndt::type &src_tp, struct_export_mode_t mode)
+      : m_storage_size(src_tp.get_data_size())
+  {
+    static const char *const records[] = {"dict", "tuple", "namedtuple"};
+    m_values.reset(pydynd::array_as_py(src_tp.extended<ndt::categorical_type>()->get_categories(), records[mode]));
+  }
+
+  uint32_t storage_value(const char *src) const
+  {
+    switch (m_storage_size) {
+    case 1:
+      return *reinterpret_cast<const uint8_t *>(src);
+    case 2:
+      return *reinterpret_cast<const uint16_t *>(src);
+    default:
+      return *reinterpret_cast<const uint32_t *>(src);
+    }
+  }
+
+  void single(char *dst, char *const *src)
+  {
+    uint32_t value = storage_value(src[0]);
+    if (value >= static_cast<size_t>(PyList_GET_SIZE(m_values.get()))) {
+      std::stringstream ss;
+      ss << "categorical storage value " << value << " is out of bounds";
+      throw std::runtime_error(ss.str());
     }
+    PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
+    PyObject *obj = PyList_GET_ITEM(m_values.get(), value);
+    Py_INCREF(obj);
+    Py_XDECREF(*dst_obj);
+    *dst_obj = obj;
   }
 };
 
@@ -435,7 +584,6 @@ struct assign_to_pyobject_kernel<ndt::tuple_type>
   }
 };
 
-// TODO: Should make a more efficient strided kernel function
 template <>
 struct assign_to_pyobject_kernel<ndt::struct_type>
     : dynd::nd::base_strided_kernel<assign_to_pyobject_kernel<ndt::struct_type>, 1> {
@@ -443,6 +591,10 @@ struct assign_to_pyobject_kernel<ndt::struct_type>
   const char *m_src_arrmeta;
   std::vector<intptr_t> m_copy_el_offsets;
   pydynd::pyobject_ownref m_field_names;
+  struct_export_mode_t m_mode;
+  // For dicts, a dict with every field name mapped to None, whose copies start each record
+  // with its key table already laid out. For namedtuples, the namedtuple class.
+  pydynd::pyobject_ownref m_template;
 
   ~assign_to_pyobject_kernel()
   {
@@ -451,6 +603,30 @@ struct assign_to_pyobject_kernel<ndt::struct_type>
     }
   }
 
+  /**
+   * Builds m_template for the export mode, called once when the kernel is instantiated.
+   */
+  void init_template()
+  {
+    intptr_t field_count = PyTuple_GET_SIZE(m_field_names.get());
+    if (m_mode == struct_export_dict) {
+      m_template.reset(PyDict_New());
+      for (intptr_t i = 0; i < field_count; ++i) {
+        if (PyDict_SetItem(m_template.get(), PyTuple_GET_ITEM(m_field_names.get(), i), Py_None) < 0) {
+          throw std::exception();
+        }
+      }
+    }
+    else if (m_mode == struct_export_namedtuple) {
+      pydynd::pyobject_ownref collections(PyImport_ImportModule("collections"));
+      pydynd::pyobject_ownref namedtuple(PyObject_GetAttrString(collections.get(), "namedtuple"));
+      pydynd::pyobject_ownref args(Py_BuildValue("(sO)", "Record", m_field_names.get()));
+      // Field names which aren't valid identifiers get positional names
+      pydynd::pyobject_ownref kwds(Py_BuildValue("{sO}", "rename", Py_True));
+      m_template.reset(PyObject_Call(namedtuple.get(), args.get(), kwds.get()));
+    }
+  }
+
   void single(char *dst, char *const *src)
   {
     PyObject **dst_obj = reinterpret_cast<PyObject **>(dst);
@@ -458,28 +634,200 @@ struct assign_to_pyobject_kernel<ndt::struct_type>
     *dst_obj = NULL;
     intptr_t field_count = m_src_tp.extended<dynd::ndt::tuple_type>()->get_field_count();
     const uintptr_t *field_offsets = reinterpret_cast<const uintptr_t *>(m_src_arrmeta);
-    pydynd::pyobject_ownref dct(PyDict_New());
+
+    if (m_mode == struct_export_dict) {
+      // Replacing the values of existing keys never resizes, and the name strings carry their hashes
+      pydynd::pyobject_ownref dct(PyDict_Copy(m_template.get()));
+      for (intptr_t i = 0; i < field_count; ++i) {
+        dynd::nd::kernel_prefix *copy_el = get_child(m_copy_el_offsets[i]);
+        dynd::kernel_single_t copy_el_fn = copy_el->get_function<dynd::kernel_single_t>();
+        char *el_src = src[0] + field_offsets[i];
+        pydynd::pyobject_ownref el;
+        copy_el_fn(copy_el, reinterpret_cast<char *>(el.obj_addr()), &el_src);
+        PyDict_SetItem(dct.get(), PyTuple_GET_ITEM(m_field_names.get(), i), el.get());
+      }
+      if (PyErr_Occurred()) {
+        throw std::exception();
+      }
+      *dst_obj = dct.release();
+      return;
+    }
+
+    // Tuples and namedtuples are allocated at their final size and filled in place
+    pydynd::pyobject_ownref tup;
+    if (m_mode == struct_export_namedtuple) {
+      PyTypeObject *record_type = reinterpret_cast<PyTypeObject *>(m_template.get());
+      tup.reset(record_type->tp_alloc(record_type, field_count));
+    }
+    else {
+      tup.reset(PyTuple_New(field_count));
+    }
     for (intptr_t i = 0; i < field_count; ++i) {
       dynd::nd::kernel_prefix *copy_el = get_child(m_copy_el_offsets[i]);
       dynd::kernel_single_t copy_el_fn = copy_el->get_function<dynd::kernel_single_t>();
       char *el_src = src[0] + field_offsets[i];
-      pydynd::pyobject_ownref el;
-      copy_el_fn(copy_el, reinterpret_cast<char *>(el.obj_addr()), &el_src);
-      PyDict_SetItem(dct.get(), PyTuple_GET_ITEM(m_field_names.get(), i), el.get());
+      char *el_dst = reinterpret_cast<char *>(((PyTupleObject *)tup.get())->ob_item + i);
+      copy_el_fn(copy_el, el_dst, &el_src);
     }
     if (PyErr_Occurred()) {
       throw std::exception();
     }
-    *dst_obj = dct.release();
+    *dst_obj = tup.release();
   }
 };
 
+/**
+ * Returns a table of the ints -128 through 255, so 8-bit values can be
+ * exported without creating any objects. It is filled on first use and
+ * lives for the rest of the process.
+ */
+inline PyObject *const *small_pyint_table()
+{
+  static PyObject *table[384] = {NULL};
+  if (table[0] == NULL) {
+    for (int i = 383; i >= 0; --i) {
+      table[i] = pyint_from_int(static_cast<int32_t>(i - 128));
+      if (table[i] == NULL) {
+        throw std::exception();
+      }
+    }
+  }
+  return table;
+}
+
+template <typename T>
+void export_contiguous_ints(PyObject **dst, const char *src, intptr_t count)
+{
+  const T *src_typed = reinterpret_cast<const T *>(src);
+  for (intptr_t i = 0; i < count; ++i) {
+    dst[i] = pyint_from_int(src_typed[i]);
+    if (dst[i] == NULL) {
+      throw std::exception();
+    }
+  }
+}
+
+template <typename T>
+void export_contiguous_small_ints(PyObject **dst, const char *src, intptr_t count)
+{
+  PyObject *const *table = small_pyint_table() + 128;
+  const T *src_typed = reinterpret_cast<const T *>(src);
+  for (intptr_t i = 0; i < count; ++i) {
+    dst[i] = table[src_typed[i]];
+    Py_INCREF(dst[i]);
+  }
+}
+
+template <typename T>
+void export_contiguous_floats(PyObject **dst, const char *src, intptr_t count)
+{
+  const T *src_typed = reinterpret_cast<const T *>(src);
+  for (intptr_t i = 0; i < count; ++i) {
+    dst[i] = PyFloat_FromDouble(src_typed[i]);
+    if (dst[i] == NULL) {
+      throw std::exception();
+    }
+  }
+}
+
+template <typename T>
+void export_contiguous_complex(PyObject **dst, const char *src, intptr_t count)
+{
+  const dynd::complex<T> *src_typed = reinterpret_cast<const dynd::complex<T> *>(src);
+  for (intptr_t i = 0; i < count; ++i) {
+    dst[i] = PyComplex_FromDoubles(src_typed[i].real(), src_typed[i].imag());
+    if (dst[i] == NULL) {
+      throw std::exception();
+    }
+  }
+}
+
+/**
+ * Fills the empty slots of a freshly allocated list directly from
+ * contiguous values of a builtin numeric type, without going through
+ * an element kernel.
+ *
+ * \param src_id  The type id of the values.
+ * \param dst  The list's item slots, which must all be NULL.
+ * \param src  The contiguous values.
+ * \param count  The number of values.
+ *
+ * \returns  False if ``src_id`` has no direct export, leaving ``dst`` untouched.
+ */
+inline bool export_contiguous_builtin(dynd::type_id_t src_id, PyObject **dst, const char *src, intptr_t count)
+{
+  switch (src_id) {
+  case dynd::bool_id:
+    for (intptr_t i = 0; i < count; ++i) {
+      dst[i] = src[i] ? Py_True : Py_False;
+      Py_INCREF(dst[i]);
+    }
+    return true;
+  case dynd::int8_id:
+    export_contiguous_small_ints<int8_t>(dst, src, count);
+    return true;
+  case dynd::uint8_id:
+    export_contiguous_small_ints<uint8_t>(dst, src, count);
+    return true;
+  case dynd::int16_id:
+    export_contiguous_ints<int16_t>(dst, src, count);
+    return true;
+  case dynd::uint16_id:
+    export_contiguous_ints<uint16_t>(dst, src, count);
+    return true;
+  case dynd::int32_id:
+    export_contiguous_ints<int32_t>(dst, src, count);
+    return true;
+  case dynd::uint32_id:
+    export_contiguous_ints<uint32_t>(dst, src, count);
+    return true;
+  case dynd::int64_id:
+    export_contiguous_ints<int64_t>(dst, src, count);
+    return true;
+  case dynd::uint64_id:
+    export_contiguous_ints<uint64_t>(dst, src, count);
+    return true;
+  case dynd::float32_id:
+    export_contiguous_floats<float>(dst, src, count);
+    return true;
+  case dynd::float64_id:
+    export_contiguous_floats<double>(dst, src, count);
+    return true;
+  case dynd::complex_float32_id:
+    export_contiguous_complex<float>(dst, src, count);
+    return true;
+  case dynd::complex_float64_id:
+    export_contiguous_complex<double>(dst, src, count);
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * The type id of a dimension's elements if they are of a builtin type and
+ * tightly packed, so the dimension can use export_contiguous_builtin, or
+ * uninitialized_id otherwise.
+ */
+inline dynd::type_id_t contiguous_builtin_id(const dynd::ndt::type &el_tp, intptr_t stride)
+{
+  if (el_tp.is_builtin() && stride == static_cast<intptr_t>(el_tp.get_data_size())) {
+    return el_tp.get_id();
+  }
+  return dynd::uninitialized_id;
+}
+
 template <>
 struct assign_to_pyobject_kernel<ndt::fixed_dim_type>
     : dynd::nd::base_strided_kernel<assign_to_pyobject_kernel<ndt::fixed_dim_type>, 1> {
   intptr_t dim_size, stride;
+  // The element type id when the elements can be exported directly, see contiguous_builtin_id
+  dynd::type_id_t el_id;
 
-  assign_to_pyobject_kernel(intptr_t dim_size, intptr_t stride) : dim_size(dim_size), stride(stride) {}
+  assign_to_pyobject_kernel(intptr_t dim_size, intptr_t stride, dynd::type_id_t el_id = dynd::uninitialized_id)
+      : dim_size(dim_size), stride(stride), el_id(el_id)
+  {
+  }
 
   ~assign_to_pyobject_kernel() { get_child()->destroy(); }
 
@@ -489,10 +837,12 @@ struct assign_to_pyobject_kernel<ndt::fixed_dim_type>
     Py_XDECREF(*dst_obj);
     *dst_obj = NULL;
     pydynd::pyobject_ownref lst(PyList_New(dim_size));
-    nd::kernel_prefix *copy_el = get_child();
-    dynd::kernel_strided_t copy_el_fn = copy_el->get_function<dynd::kernel_strided_t>();
-    copy_el_fn(copy_el, reinterpret_cast<char *>(((PyListObject *)lst.get())->ob_item), sizeof(PyObject *), src,
-               &stride, dim_size);
+    PyObject **items = ((PyListObject *)lst.get())->ob_item;
+    if (!export_contiguous_builtin(el_id, items, src[0], dim_size)) {
+      nd::kernel_prefix *copy_el = get_child();
+      dynd::kernel_strided_t copy_el_fn = copy_el->get_function<dynd::kernel_strided_t>();
+      copy_el_fn(copy_el, reinterpret_cast<char *>(items), sizeof(PyObject *), src, &stride, dim_size);
+    }
     if (PyErr_Occurred()) {
       throw std::exception();
     }
@@ -504,8 +854,13 @@ template <>
 struct assign_to_pyobject_kernel<ndt::var_dim_type>
     : dynd::nd::base_strided_kernel<assign_to_pyobject_kernel<ndt::var_dim_type>, 1> {
   intptr_t offset, stride;
+  // The element type id when the elements can be exported directly, see contiguous_builtin_id
+  dynd::type_id_t el_id;
 
-  assign_to_pyobject_kernel(intptr_t offset, intptr_t stride) : offset(offset), stride(stride) {}
+  assign_to_pyobject_kernel(intptr_t offset, intptr_t stride, dynd::type_id_t el_id = dynd::uninitialized_id)
+      : offset(offset), stride(stride), el_id(el_id)
+  {
+  }
 
   ~assign_to_pyobject_kernel() { get_child()->destroy(); }
 
@@ -516,11 +871,13 @@ struct assign_to_pyobject_kernel<ndt::var_dim_type>
     *dst_obj = NULL;
     const dynd::ndt::var_dim_type::data_type *vd = reinterpret_cast<const dynd::ndt::var_dim_type::data_type *>(src[0]);
     pydynd::pyobject_ownref lst(PyList_New(vd->size));
-    dynd::nd::kernel_prefix *copy_el = get_child();
-    dynd::kernel_strided_t copy_el_fn = copy_el->get_function<dynd::kernel_strided_t>();
+    PyObject **items = ((PyListObject *)lst.get())->ob_item;
     char *el_src = vd->begin + offset;
-    copy_el_fn(copy_el, reinterpret_cast<char *>(((PyListObject *)lst.get())->ob_item), sizeof(PyObject *), &el_src,
-               &stride, vd->size);
+    if (!export_contiguous_builtin(el_id, items, el_src, vd->size)) {
+      dynd::nd::kernel_prefix *copy_el = get_child();
+      dynd::kernel_strided_t copy_el_fn = copy_el->get_function<dynd::kernel_strided_t>();
+      copy_el_fn(copy_el, reinterpret_cast<char *>(items), sizeof(PyObject *), &el_src, &stride, vd->size);
+    }
     if (PyErr_Occurred()) {
       throw std::exception();
     }
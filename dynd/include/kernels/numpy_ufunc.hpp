@@ -1,17 +1,36 @@
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+
 #include <dynd/kernels/base_kernel.hpp>
 
+#include "numpy_interop.hpp"
+#include "utility_functions.hpp"
+
 namespace pydynd {
 namespace nd {
   namespace functional {
 
+    /**
+     * One inner loop of a NumPy ufunc, shared by every ckernel built from it.
+     * Owns a reference to the ufunc so ``funcptr`` and ``ufunc_data`` stay valid.
+     */
     struct scalar_ufunc_data {
       PyUFuncObject *ufunc;
       PyUFuncGenericFunction funcptr;
       void *ufunc_data;
       intptr_t param_count;
 
+      scalar_ufunc_data(PyUFuncObject *ufunc, PyUFuncGenericFunction funcptr, void *ufunc_data, intptr_t param_count)
+          : ufunc(ufunc), funcptr(funcptr), ufunc_data(ufunc_data), param_count(param_count)
+      {
+        Py_INCREF(ufunc);
+      }
+
+      scalar_ufunc_data(const scalar_ufunc_data &) = delete;
+      scalar_ufunc_data &operator=(const scalar_ufunc_data &) = delete;
+
       ~scalar_ufunc_data()
       {
         if (ufunc != NULL) {
@@ -20,132 +39,95 @@ namespace nd {
           Py_DECREF(ufunc);
         }
       }
+
+      /**
+       * Calls the inner loop on ``count`` elements, ``NPY_BUFSIZE`` elements at a time, which is
+       * how NumPy drives its own loops. When ``gil`` is set the GIL is held for each chunk only,
+       * so other Python threads can run in between, and an error raised by the loop stops it.
+       */
+      template <bool gil>
+      void call(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count) const
+      {
+        char *args[NPY_MAXARGS];
+        intptr_t strides[NPY_MAXARGS];
+        // Set up the args array the way the numpy ufunc wants it
+        memcpy(&args[0], &src[0], param_count * sizeof(char *));
+        args[param_count] = dst;
+        memcpy(&strides[0], &src_stride[0], param_count * sizeof(intptr_t));
+        strides[param_count] = dst_stride;
+
+        while (count > 0) {
+          intptr_t chunk = static_cast<intptr_t>(std::min<size_t>(count, NPY_BUFSIZE));
+          if (gil) {
+            PyGILState_RAII pgs;
+            funcptr(args, &chunk, strides, ufunc_data);
+            if (PyErr_Occurred()) {
+              throw std::exception();
+            }
+          }
+          else {
+            funcptr(args, &chunk, strides, ufunc_data);
+          }
+          for (intptr_t i = 0; i <= param_count; ++i) {
+            args[i] += chunk * strides[i];
+          }
+          count -= chunk;
+        }
+      }
     };
 
     template <bool gil>
     struct scalar_ufunc_ck;
 
+    /**
+     * Runs an inner loop which doesn't touch Python objects. A strided call of at least
+     * ``NPY_BUFSIZE`` elements made while holding the GIL releases it for the duration of the loop.
+     */
     template <>
-    struct scalar_ufunc_ck<false>
-        : dynd::nd::base_strided_kernel<scalar_ufunc_ck<false>, 1> {
-      typedef scalar_ufunc_ck self_type;
-
+    struct scalar_ufunc_ck<false> : dynd::nd::base_strided_kernel<scalar_ufunc_ck<false>> {
       const scalar_ufunc_data *data;
 
       scalar_ufunc_ck(const scalar_ufunc_data *data) : data(data) {}
 
       void single(char *dst, char *const *src)
       {
-        char *args[NPY_MAXARGS];
-        // Set up the args array the way the numpy ufunc wants it
-        memcpy(&args[0], &src[0], data->param_count * sizeof(void *));
-        args[data->param_count] = dst;
-        // Call the ufunc loop with a dim size of 1
-        intptr_t dimsize = 1;
-        intptr_t strides[NPY_MAXARGS];
-        memset(strides, 0, (data->param_count + 1) * sizeof(intptr_t));
-        data->funcptr(args, &dimsize, strides, data->ufunc_data);
+        intptr_t strides[NPY_MAXARGS] = {0};
+        data->call<false>(dst, 0, src, strides, 1);
       }
 
-      void strided(char *dst, intptr_t dst_stride, char *const *src,
-                   const intptr_t *src_stride, size_t count)
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
       {
-        char *args[NPY_MAXARGS];
-        // Set up the args array the way the numpy ufunc wants it
-        memcpy(&args[0], &src[0], data->param_count * sizeof(void *));
-        args[data->param_count] = dst;
-        // Call the ufunc loop with a dim size of 1
-        intptr_t strides[NPY_MAXARGS];
-        memcpy(&strides[0], &src_stride[0],
-               data->param_count * sizeof(intptr_t));
-        strides[data->param_count] = dst_stride;
-        data->funcptr(args, reinterpret_cast<intptr_t *>(&count), strides,
-                      data->ufunc_data);
-      }
+#if PY_VERSION_HEX >= 0x03040000
+        if (count >= NPY_BUFSIZE && PyGILState_Check()) {
+          PyThreadState *thread_state = PyEval_SaveThread();
+          data->call<false>(dst, dst_stride, src, src_stride, count);
+          PyEval_RestoreThread(thread_state);
+          return;
+        }
+#endif
 
-      static void
-      instantiate(char *static_data, char *DYND_UNUSED(data),
-                  kernel_builder *ckb, intptr_t ckb_offset,
-                  const dynd::ndt::type &dst_tp,
-                  const char *DYND_UNUSED(dst_arrmeta),
-                  intptr_t DYND_UNUSED(nsrc), const dynd::ndt::type *src_tp,
-                  const char *const *DYND_UNUSED(src_arrmeta),
-                  dynd::kernel_request_t kernreq,
-                  const dynd::eval::eval_context *DYND_UNUSED(ectx),
-                  intptr_t nkwd, const dynd::nd::array *kwds,
-                  const std::map<std::string, dynd::ndt::type> &tp_vars)
-      {
-        // Acquire the GIL for creating the ckernel
-        PyGILState_RAII pgs;
-        self_type::make(
-            ckb, kernreq,
-            reinterpret_cast<std::shared_ptr<scalar_ufunc_data> *>(static_data)
-                ->get());
+        data->call<false>(dst, dst_stride, src, src_stride, count);
       }
     };
 
+    /**
+     * Runs an inner loop which operates on Python objects, acquiring the GIL around it.
+     */
     template <>
-    struct scalar_ufunc_ck<true>
-        : dynd::nd::base_strided_kernel<scalar_ufunc_ck<true>, 1> {
-      typedef scalar_ufunc_ck self_type;
-
+    struct scalar_ufunc_ck<true> : dynd::nd::base_strided_kernel<scalar_ufunc_ck<true>> {
       const scalar_ufunc_data *data;
 
       scalar_ufunc_ck(const scalar_ufunc_data *data) : data(data) {}
 
       void single(char *dst, char *const *src)
       {
-        char *args[NPY_MAXARGS];
-        // Set up the args array the way the numpy ufunc wants it
-        memcpy(&args[0], &src[0], data->param_count * sizeof(void *));
-        args[data->param_count] = dst;
-        // Call the ufunc loop with a dim size of 1
-        intptr_t dimsize = 1;
-        intptr_t strides[NPY_MAXARGS];
-        memset(strides, 0, (data->param_count + 1) * sizeof(void *));
-        {
-          PyGILState_RAII pgs;
-          data->funcptr(args, &dimsize, strides, data->ufunc_data);
-        }
-      }
-
-      void strided(char *dst, intptr_t dst_stride, char *const *src,
-                   const intptr_t *src_stride, size_t count)
-      {
-        char *args[NPY_MAXARGS];
-        // Set up the args array the way the numpy ufunc wants it
-        memcpy(&args[0], &src[0], data->param_count * sizeof(void *));
-        args[data->param_count] = dst;
-        // Call the ufunc loop with a dim size of 1
-        intptr_t strides[NPY_MAXARGS];
-        memcpy(&strides[0], &src_stride[0],
-               data->param_count * sizeof(intptr_t));
-        strides[data->param_count] = dst_stride;
-        {
-          PyGILState_RAII pgs;
-          data->funcptr(args, reinterpret_cast<intptr_t *>(&count), strides,
-                        data->ufunc_data);
-        }
+        intptr_t strides[NPY_MAXARGS] = {0};
+        data->call<true>(dst, 0, src, strides, 1);
       }
 
-      static intptr_t
-      instantiate(char *static_data, char *DYND_UNUSED(data), void *ckb,
-                  intptr_t ckb_offset, const dynd::ndt::type &dst_tp,
-                  const char *DYND_UNUSED(dst_arrmeta),
-                  intptr_t DYND_UNUSED(nsrc), const dynd::ndt::type *src_tp,
-                  const char *const *DYND_UNUSED(src_arrmeta),
-                  dynd::kernel_request_t kernreq,
-                  const dynd::eval::eval_context *DYND_UNUSED(ectx),
-                  intptr_t nkwd, const dynd::nd::array *kwds,
-                  const std::map<std::string, dynd::ndt::type> &tp_vars)
+      void strided(char *dst, intptr_t dst_stride, char *const *src, const intptr_t *src_stride, size_t count)
       {
-        // Acquire the GIL for creating the ckernel
-        PyGILState_RAII pgs;
-        self_type::make(
-            ckb, kernreq, ckb_offset,
-            reinterpret_cast<std::shared_ptr<scalar_ufunc_data> *>(static_data)
-                ->get());
-        return ckb_offset;
+        data->call<true>(dst, dst_stride, src, src_stride, count);
       }
     };
 
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -153,18 +154,60 @@ inline dynd::ndt::type make_struct_type_from_numpy_struct(PyArray_Descr *d, size
 }
 
 /**
- * Converts a numpy dtype to a dynd type. Use the data_alignment
- * parameter to get accurate alignment, as Numpy may have misaligned data,
- * or may report a smaller alignment than is necessary based on the data.
+ * Looks up the dynd type for the numpy dtype ``d`` and data alignment in
+ * the conversion cache. The cache holds a bounded number of recent
+ * conversions, keyed on the identity of the dtype object, and must only
+ * be used with the GIL held.
  *
- * \param d  The numpy dtype to convert.
- * \param data_alignment  If associated with particular data, the actual
- *                        alignment of that data. The default of zero
- *                        causes it to use Numpy's data alignment.
+ * \returns  True if ``out_tp`` was set from the cache.
+ */
+PYDYND_API bool numpy_dtype_cache_lookup(PyArray_Descr *d, size_t data_alignment, dynd::ndt::type &out_tp);
+
+/**
+ * Stores the dynd type converted from the numpy dtype ``d`` and data
+ * alignment in the conversion cache, evicting the oldest entry if it is
+ * full.
+ */
+PYDYND_API void numpy_dtype_cache_store(PyArray_Descr *d, size_t data_alignment, const dynd::ndt::type &tp);
+
+/**
+ * Looks up the numpy dtype for the dynd type ``tp`` in the conversion
+ * cache, with the same bounds and GIL requirement as the other direction.
  *
- * \returns  The dynd equivalent of the numpy dtype.
+ * \returns  A new copy of the dtype, which the caller may modify, or NULL
+ *           if it isn't cached.
  */
-inline dynd::ndt::type _type_from_numpy_dtype(PyArray_Descr *d, size_t data_alignment)
+PYDYND_API PyArray_Descr *numpy_type_cache_lookup(const dynd::ndt::type &tp);
+
+/**
+ * Stores the numpy dtype converted from the dynd type ``tp`` in the
+ * conversion cache, which keeps its own copy of ``d``.
+ */
+PYDYND_API void numpy_type_cache_store(const dynd::ndt::type &tp, PyArray_Descr *d);
+
+/**
+ * The hit and miss counts of the dtype/type conversion caches of this
+ * module, for numpy dtypes to dynd types and back.
+ */
+struct numpy_type_cache_stats {
+  intptr_t dtype_hits;
+  intptr_t dtype_misses;
+  intptr_t type_hits;
+  intptr_t type_misses;
+  intptr_t size;
+};
+
+PYDYND_API numpy_type_cache_stats get_numpy_type_cache_stats();
+
+/**
+ * Empties the dtype/type conversion caches and resets their counts.
+ */
+PYDYND_API void clear_numpy_type_cache();
+
+/**
+ * Converts a numpy dtype to a dynd type, without the conversion cache.
+ */
+inline dynd::ndt::type _type_from_numpy_dtype_uncached(PyArray_Descr *d, size_t data_alignment)
 {
   dynd::ndt::type dt;
 
@@ -269,11 +312,13 @@ inline dynd::ndt::type _type_from_numpy_dtype(PyArray_Descr *d, size_t data_alig
   case NPY_DATETIME: {
     // Get the dtype info through the CPython API, slower
     // but lets NumPy's datetime API change without issue.
+    // DyND has no datetime type, so this is rejected below,
+    // and nd.view(a, ticks=True) views the int64 ticks instead.
     pyobject_ownref mod(PyImport_ImportModule("numpy"));
     pyobject_ownref dd(PyObject_CallMethod(mod.get(), const_cast<char *>("datetime_data"), const_cast<char *>("O"), d));
     PyObject *unit = PyTuple_GetItem(dd.get(), 0);
     if (unit == NULL) {
-      throw std::runtime_error("");
+      throw std::exception();
     }
     break;
   }
@@ -303,6 +348,35 @@ inline dynd::ndt::type _type_from_numpy_dtype(PyArray_Descr *d, size_t data_alig
   return dt;
 }
 
+/**
+ * Converts a numpy dtype to a dynd type. Use the data_alignment
+ * parameter to get accurate alignment, as Numpy may have misaligned data,
+ * or may report a smaller alignment than is necessary based on the data.
+ *
+ * \param d  The numpy dtype to convert.
+ * \param data_alignment  If associated with particular data, the actual
+ *                        alignment of that data. The default of zero
+ *                        causes it to use Numpy's data alignment.
+ *
+ * \returns  The dynd equivalent of the numpy dtype.
+ */
+inline dynd::ndt::type _type_from_numpy_dtype(PyArray_Descr *d, size_t data_alignment)
+{
+  // Struct and subarray dtypes are read through the Python API, so those
+  // conversions are cached. Raw alignment bits from data pointers and
+  // strides would fill the cache with one-off keys, so they aren't.
+  if ((!PyDataType_HASFIELDS(d) && !PyDataType_HASSUBARRAY(d)) || data_alignment > 16) {
+    return _type_from_numpy_dtype_uncached(d, data_alignment);
+  }
+
+  dynd::ndt::type tp;
+  if (!numpy_dtype_cache_lookup(d, data_alignment, tp)) {
+    tp = _type_from_numpy_dtype_uncached(d, data_alignment);
+    numpy_dtype_cache_store(d, data_alignment, tp);
+  }
+  return tp;
+}
+
 /**
  * Converts a dynd type to a numpy dtype.
  *
@@ -337,6 +411,71 @@ dynd::ndt::type _type_of_numpy_scalar(PyObject *obj);
 dynd::ndt::type PYDYND_API array_from_numpy_array2(PyArrayObject *obj);
 dynd::ndt::type array_from_numpy_scalar2(PyObject *obj);
 
+/**
+ * Calls ``f`` on each element of a numpy object array, in C order,
+ * until it returns false.
+ *
+ * \param obj  The numpy array, which must have an object dtype.
+ * \param f  A callable taking a ``PyObject *`` and returning bool.
+ */
+template <typename Func>
+void for_each_numpy_object(PyArrayObject *obj, Func &&f)
+{
+  if (PyArray_SIZE(obj) == 0) {
+    return;
+  }
+
+  NpyIter *iter = NpyIter_New(obj, NPY_ITER_READONLY | NPY_ITER_EXTERNAL_LOOP | NPY_ITER_REFS_OK, NPY_CORDER,
+                              NPY_NO_CASTING, NULL);
+  if (iter == NULL) {
+    throw std::exception();
+  }
+  std::unique_ptr<NpyIter, int (*)(NpyIter *)> iter_owner(iter, &NpyIter_Deallocate);
+  NpyIter_IterNextFunc *iternext = NpyIter_GetIterNext(iter, NULL);
+  if (iternext == NULL) {
+    throw std::exception();
+  }
+
+  char **data_ptr = NpyIter_GetDataPtrArray(iter);
+  npy_intp *stride_ptr = NpyIter_GetInnerStrideArray(iter);
+  npy_intp *size_ptr = NpyIter_GetInnerLoopSizePtr(iter);
+  do {
+    char *data = *data_ptr;
+    for (npy_intp i = 0; i < *size_ptr; ++i, data += *stride_ptr) {
+      if (!f(*reinterpret_cast<PyObject **>(data))) {
+        return;
+      }
+    }
+  } while (iternext(iter));
+}
+
+/**
+ * Whether ``obj`` is a python string, which converts to a dynd string.
+ */
+inline bool is_pystring(PyObject *obj)
+{
+#if PY_VERSION_HEX < 0x03000000
+  if (PyString_Check(obj)) {
+    return true;
+  }
+#endif
+  return PyUnicode_Check(obj) != 0;
+}
+
+/**
+ * Deduces the dynd element type of a numpy object array holding python
+ * strings, checking each element once. This is ``string``, or ``?string``
+ * when some of the elements are None, and an uninitialized type if any
+ * element is something else, or all of them are None.
+ *
+ * \param obj  The numpy array, which must have an object dtype.
+ * \param out_utf8  If not NULL, on Python 3.3+ this receives the UTF-8 data
+ *                  of every element in C order when none of them is None,
+ *                  and is left empty otherwise.
+ */
+dynd::ndt::type PYDYND_API string_type_of_numpy_objects(
+    PyArrayObject *obj, std::vector<std::pair<const char *, Py_ssize_t>> *out_utf8 = NULL);
+
 /**
  * Returns the numpy kind ('i', 'f', etc) of the array.
  */
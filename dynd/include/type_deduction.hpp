@@ -9,6 +9,7 @@
 #include <dynd/type.hpp>
 #include <dynd/type_promotion.hpp>
 #include <dynd/types/string_type.hpp>
+#include <dynd/types/tuple_type.hpp>
 #include <dynd/types/type_id.hpp>
 
 #include "type_conversions.hpp"
@@ -28,10 +29,100 @@ enum shape_deduction_t {
   pydynd_shape_deduction_uninitialized = -4
 };
 
+/**
+ * Returns the smallest of int32, int64, uint64 and int128 which holds
+ * the value of the Python int ``obj``. Values beyond int128 also give
+ * int128, so that converting them reports the overflow.
+ *
+ * \param obj  The Python int to analyze.
+ * \param out_negative  Set to whether the value is negative.
+ */
+PYDYND_API dynd::ndt::type pyint_type_for(PyObject *obj, bool &out_negative);
+
+/**
+ * Promotes two of the integer types returned by pyint_type_for, going
+ * through int64 -> uint64 -> int128. Mixing uint64 values with negative
+ * ones needs int128, so whether any negative value has been seen is
+ * passed in separately.
+ */
+inline dynd::ndt::type promote_pyint_types(const dynd::ndt::type &tp0, const dynd::ndt::type &tp1,
+                                           bool negative_seen)
+{
+  if (tp0.get_id() == dynd::int128_id || tp1.get_id() == dynd::int128_id) {
+    return dynd::ndt::make_type<dynd::int128>();
+  }
+  if (tp0.get_id() == dynd::uint64_id || tp1.get_id() == dynd::uint64_id) {
+    return negative_seen ? dynd::ndt::make_type<dynd::int128>() : dynd::ndt::make_type<uint64_t>();
+  }
+  return dynd::promote_types_arithmetic(tp0, tp1);
+}
+
+inline bool is_pyint_deduced_type(const dynd::ndt::type &tp)
+{
+  switch (tp.get_id()) {
+  case dynd::int32_id:
+  case dynd::int64_id:
+  case dynd::uint64_id:
+  case dynd::int128_id:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * Returns whether a tuple is a record rather than a dimension.
+ * Namedtuples and other tuple subclasses are records, as are tuples
+ * whose items mix numbers, strings, nested sequences or other
+ * objects, like (1, 'a'). None items match anything.
+ */
+PYDYND_API bool is_pytuple_record(PyObject *obj);
+
+/**
+ * Deduces the tuple type of a record tuple, e.g. (int32, string)
+ * for (1, 'a').
+ */
+PYDYND_API dynd::ndt::type pytuple_record_type_for(PyObject *obj);
+
+/**
+ * Promotes the types deduced for two Python scalars, promoting
+ * records field by field. Returns a null type when two records
+ * have different numbers of fields.
+ */
+inline dynd::ndt::type promote_pyscalar_types(const dynd::ndt::type &tp0, const dynd::ndt::type &tp1,
+                                              bool negative_seen)
+{
+  if (is_pyint_deduced_type(tp0) && is_pyint_deduced_type(tp1)) {
+    return promote_pyint_types(tp0, tp1, negative_seen);
+  }
+  if (tp0 == tp1 || tp1.get_id() == dynd::void_id) {
+    return tp0;
+  }
+  if (tp0.get_id() == dynd::tuple_id && tp1.get_id() == dynd::tuple_id) {
+    const dynd::ndt::tuple_type *tt0 = tp0.extended<dynd::ndt::tuple_type>();
+    const dynd::ndt::tuple_type *tt1 = tp1.extended<dynd::ndt::tuple_type>();
+    intptr_t field_count = tt0->get_field_count();
+    if (tt1->get_field_count() != field_count) {
+      return dynd::ndt::type();
+    }
+    std::vector<dynd::ndt::type> field_types(field_count);
+    for (intptr_t i = 0; i < field_count; ++i) {
+      field_types[i] = promote_pyscalar_types(tt0->get_field_type(i), tt1->get_field_type(i), negative_seen);
+      if (field_types[i].get_id() == dynd::uninitialized_id) {
+        return dynd::ndt::type();
+      }
+    }
+    return dynd::ndt::make_type<dynd::ndt::tuple_type>(field_types);
+  }
+  return dynd::promote_types_arithmetic(tp0, tp1);
+}
+
 /**
  * This function iterates over the elements of the provided
  * object, recursively deducing the shape and data type
- * of it as an array.
+ * of it as an array. Lists and tuples are treated as
+ * dimensions, except for record tuples (see is_pytuple_record),
+ * which are deduced as tuple types.
  *
  * \param obj  The Python object to analyze.
  * \param shape  The shape being built up. It should start as an empty
@@ -43,12 +134,15 @@ enum shape_deduction_t {
  *            deduced.
  * \param current_axis  The index of the axis within the shape corresponding
  *                      to the object.
+ * \param negative_int_seen  Tracks whether any negative int has been seen,
+ *                           for promoting to uint64 or int128. It should
+ *                           start as false.
  */
 inline void deduce_pylist_shape_and_dtype(PyObject *obj, std::vector<intptr_t> &shape, dynd::ndt::type &tp,
-                                          size_t current_axis)
+                                          size_t current_axis, bool &negative_int_seen)
 {
-  if (PyList_Check(obj)) {
-    Py_ssize_t size = PyList_GET_SIZE(obj);
+  if (PyList_Check(obj) || (PyTuple_Check(obj) && !is_pytuple_record(obj))) {
+    Py_ssize_t size = PySequence_Fast_GET_SIZE(obj);
     if (shape.size() == current_axis) {
       if (tp.get_id() == dynd::void_id) {
         shape.push_back(size);
@@ -66,7 +160,7 @@ inline void deduce_pylist_shape_and_dtype(PyObject *obj, std::vector<intptr_t> &
     }
 
     for (Py_ssize_t i = 0; i < size; ++i) {
-      deduce_pylist_shape_and_dtype(PyList_GET_ITEM(obj, i), shape, tp, current_axis + 1);
+      deduce_pylist_shape_and_dtype(PySequence_Fast_GET_ITEM(obj, i), shape, tp, current_axis + 1, negative_int_seen);
       // Propagate uninitialized_id as a signal an
       // undeducable object was encountered
       if (tp.get_id() == dynd::uninitialized_id) {
@@ -88,16 +182,22 @@ inline void deduce_pylist_shape_and_dtype(PyObject *obj, std::vector<intptr_t> &
     if (PyUnicode_Check(obj)) {
       obj_tp = dynd::ndt::make_type<dynd::ndt::string_type>();
     }
+    else if (PyLong_Check(obj) && !PyBool_Check(obj)) {
+#else
+    if ((PyInt_Check(obj) || PyLong_Check(obj)) && !PyBool_Check(obj)) {
+#endif
+      bool negative = false;
+      obj_tp = pyint_type_for(obj, negative);
+      negative_int_seen = negative_int_seen || negative;
+    }
+    else if (PyTuple_Check(obj)) {
+      obj_tp = pytuple_record_type_for(obj);
+    }
     else {
       obj_tp = pydynd::dynd_ndt_cpp_type_for(obj);
     }
-#else
-    obj_tp = pydynd::dynd_ndt_cpp_type_for(obj);
-#endif
 
-    if (tp != obj_tp) {
-      tp = dynd::promote_types_arithmetic(obj_tp, tp);
-    }
+    tp = promote_pyscalar_types(obj_tp, tp, negative_int_seen);
   }
 }
 
@@ -176,6 +176,43 @@ inline int pyobject_as_int_index(PyObject *index)
   return (int)result;
 }
 
+/**
+ * Converts a Python int to an int128, raising OverflowError if it
+ * doesn't fit. The value fits exactly when its floor shift right
+ * by 64 bits fits in an int64, which then gives the high half.
+ */
+inline dynd::int128 pyint_as_int128(PyObject *obj)
+{
+#if PY_VERSION_HEX < 0x03000000
+  if (PyInt_Check(obj)) {
+    return dynd::int128(static_cast<long long>(PyInt_AS_LONG(obj)));
+  }
+#endif
+  int overflow = 0;
+  PY_LONG_LONG value = PyLong_AsLongLongAndOverflow(obj, &overflow);
+  if (value == -1 && PyErr_Occurred()) {
+    throw std::exception();
+  }
+  if (overflow == 0) {
+    return dynd::int128(static_cast<long long>(value));
+  }
+
+  uint64_t lo = PyLong_AsUnsignedLongLongMask(obj);
+  if (lo == static_cast<uint64_t>(-1) && PyErr_Occurred()) {
+    throw std::exception();
+  }
+  pyobject_ownref sixtyfour(PyLong_FromLong(64));
+  pyobject_ownref hi_obj(PyNumber_Rshift(obj, sixtyfour.get()));
+  PY_LONG_LONG hi = PyLong_AsLongLongAndOverflow(hi_obj.get(), &overflow);
+  if (hi == -1 && PyErr_Occurred()) {
+    throw std::exception();
+  }
+  if (overflow != 0) {
+    throw std::overflow_error("int is too big to fit in an int128");
+  }
+  return dynd::int128(static_cast<uint64_t>(hi), lo);
+}
+
 inline dynd::irange pyobject_as_irange(PyObject *index)
 {
   if (PySlice_Check(index)) {
@@ -226,6 +263,36 @@ inline std::string pystring_as_string(PyObject *str)
   }
 }
 
+#if PY_VERSION_HEX >= 0x03030000
+/**
+ * Returns a pointer to the UTF-8 data of a Python str without
+ * creating a temporary bytes object. Compact ASCII strings are read
+ * straight from their character data, other strings use the UTF-8
+ * form CPython caches on the object.
+ *
+ * \param obj  The str object, which must remain alive while the
+ *             returned data is in use.
+ * \param out_len  Receives the length in bytes of the UTF-8 data.
+ */
+inline const char *pyunicode_as_utf8(PyObject *obj, Py_ssize_t &out_len)
+{
+#if PY_VERSION_HEX < 0x030C0000
+  if (PyUnicode_READY(obj) < 0) {
+    throw std::exception();
+  }
+#endif
+  if (PyUnicode_IS_COMPACT_ASCII(obj)) {
+    out_len = PyUnicode_GET_LENGTH(obj);
+    return reinterpret_cast<const char *>(PyUnicode_DATA(obj));
+  }
+  const char *s = PyUnicode_AsUTF8AndSize(obj, &out_len);
+  if (s == NULL) {
+    throw std::exception();
+  }
+  return s;
+}
+#endif
+
 inline PyObject *pystring_from_string(const char *str)
 {
 #if PY_VERSION_HEX >= 0x03000000
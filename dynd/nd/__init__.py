@@ -58,7 +58,8 @@ from dynd.config import *
 
 from .array import array, asarray, type_of, dshape_of, as_py, view, \
     ones, zeros, empty, is_c_contiguous, is_f_contiguous, old_range, \
-    parse_json, squeeze, dtype_of, old_linspace, fields, ndim_of
+    parse_json, squeeze, dtype_of, old_linspace, fields, ndim_of, fromiter, \
+    pyview, set_copy_threading, datetime_ticks, packed_buffers
 from .callable import callable
 
 inf = float('inf')
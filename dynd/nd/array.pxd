@@ -1,4 +1,5 @@
 from cpython.object cimport PyObject
+from libc.stdint cimport intptr_t
 
 from ..cpp.array cimport array as _array
 from ..cpp.callable cimport callable as _callable
@@ -7,6 +8,10 @@ from ..cpp.type cimport type as _type
 cdef api class array(object)[object dynd_nd_array_pywrapper,
                              type dynd_nd_array_pywrapper_type]:
     cdef _array v
+    # A weak reference to the NumPy view of a read-only array
+    cdef object _numpy_view_ref
+
+    cdef object _numpy_view(self)
 
 cdef _array as_cpp_array(object obj) except *
 cpdef array asarray(object obj)
@@ -16,4 +21,6 @@ cdef api _array *dynd_nd_array_to_ptr(array) nogil except *
 cdef api array dynd_nd_array_from_cpp(_array)
 
 cdef _callable _functional_apply(_type t, object o) except *
+cdef _callable _functional_apply_chunk(_type t, object o, intptr_t chunk_size) except *
+cdef _callable _functional_from_ufunc(object o) except *
 cdef void _registry_assign_init() except *
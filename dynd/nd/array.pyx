@@ -5,16 +5,20 @@ _builtin_type = type
 from cpython.object cimport (Py_LT, Py_LE, Py_EQ, Py_NE, Py_GE, Py_GT,
                              PyObject_TypeCheck, PyTypeObject)
 from cpython.buffer cimport PyObject_CheckBuffer
+from cpython.iterator cimport PyIter_Check
 from libcpp.string cimport string
 from libcpp.map cimport map
 from libcpp cimport bool as cpp_bool
 from libcpp.complex cimport complex as cpp_complex
 from cython.operator import dereference
 from libcpp.vector cimport vector
+from libc.stdint cimport intptr_t, uint32_t
 import numpy as _np
+import weakref as _weakref
 
 from ..cpp.array cimport (groupby as dynd_groupby, empty as cpp_empty,
-                          dtyped_zeros, dtyped_ones, dtyped_empty, array_and)
+                          dtyped_zeros, dtyped_ones, dtyped_empty, array_and,
+                          write_access_flag)
 from ..cpp.arithmetic cimport pow
 from ..cpp.type cimport make_type
 from ..cpp.callable cimport get
@@ -60,15 +64,38 @@ cdef extern from 'array_functions.hpp' namespace 'pydynd':
 
     int array_getbuffer_pep3118(object ndo, Py_buffer *buffer, int flags) except -1
     int array_releasebuffer_pep3118(object ndo, Py_buffer *buffer) except -1
+    void array_as_packed_pep3118(_array&, _array&, _array&) except +translate_exception
 
 cdef extern from "array_from_py.hpp" namespace "pydynd":
     void init_array_from_py() except *
+    _array array_from_pyseq_speculative(object) except +translate_exception
+    _array array_from_pyseq_speculative(object, bint) except +translate_exception
+    _array array_from_pyiter(object, _type&, intptr_t) except +translate_exception
+    _array array_from_pydatetimes(object, string) except +translate_exception
+
+cdef extern from "array_from_pep3118.hpp" namespace "pydynd":
+    _array array_from_pep3118(object, uint32_t, bint) except +translate_exception
+
+cdef extern from 'assign.hpp':
+    object array_as_py(_array&, string) except +translate_exception
+    void set_numpy_copy_threading(intptr_t, intptr_t, intptr_t) except +translate_exception
+    void get_numpy_copy_threading(intptr_t&, intptr_t&, intptr_t&)
 
 cdef extern from 'numpy_interop.hpp' namespace 'pydynd':
     # Have Cython use an integer to represent the bool argument.
     # It will convert implicitly to bool at the C++ level.
     _array array_from_numpy_array_cast(PyObject*, unsigned int, bint)
 
+cdef extern from 'numpy_type_interop.hpp' namespace 'pydynd':
+    cdef struct numpy_type_cache_stats:
+        intptr_t dtype_hits
+        intptr_t dtype_misses
+        intptr_t type_hits
+        intptr_t type_misses
+        intptr_t size
+    numpy_type_cache_stats get_numpy_type_cache_stats()
+    void clear_numpy_type_cache()
+
 cdef extern from 'init.hpp' namespace 'pydynd':
     void numpy_interop_init() except *
 
@@ -80,6 +107,7 @@ ctypedef cpp_complex[double] cpp_complex_double
 # Alias the builtin name `type` so it can be used in functions where it isn't
 # in scope due to argument naming.
 _builtin_type = type
+_builtin_range_type = type(range(0))
 
 # Initialize C level static interop data
 numpy_interop_init()
@@ -114,6 +142,14 @@ cdef class array(object):
         If provided, the type is used as the full type for the input.
         If needed by the type, the shape is deduced from the input.
         This parameter cannot be used together with 'dtype'.
+    encode: None or 'auto', optional
+        If 'auto', a sequence of strings with few distinct values is
+        dictionary-encoded, producing a categorical type whose
+        categories are the distinct strings in order of first
+        appearance. Otherwise, or if there are too many distinct
+        values, the usual type is deduced. Sequences other than lists
+        and tuples, and iterators, are gathered into a list first, and
+        any other value raises a TypeError.
     access:  'readwrite'/'rw', 'readonly'/'r', or 'immutable', optional
         If provided, this specifies the access control for the
         created array. If the array is being allocated, as in
@@ -145,13 +181,63 @@ cdef class array(object):
              type="2 * date")
     """
 
-    def __init__(self, value = None, type = None):
+    def __init__(self, value = None, type = None, dtype = None, encode = None):
 
         if value is None and type is None:
             return
 
+        if encode is not None:
+            if encode != 'auto':
+                raise ValueError("Invalid encode {!r}, expected None or 'auto'".format(encode))
+            if type is not None or dtype is not None:
+                raise ValueError("Cannot use 'encode' together with 'type' or 'dtype'")
+            if _builtin_type(value) is not list and _builtin_type(value) is not tuple:
+                if PyIter_Check(value) or (isinstance(value, _Sequence) and
+                                           not isinstance(value, (bytes, unicode))):
+                    # Other sequences and iterators are gathered once, so
+                    # the encoding sees every value
+                    value = list(value)
+                else:
+                    raise TypeError("encode='auto' requires a sequence or iterator of values, "
+                                    "not {}".format(_builtin_type(value).__name__))
+            # Low-cardinality string sequences become categorical
+            self.v = array_from_pyseq_speculative(value, True)
+            if not self.v.is_null():
+                return
+
         cdef _type dst_tp
-        if type is None:
+        cdef _array src
+        if dtype is not None:
+            if type is not None:
+                raise ValueError("Must provide only one of 'dtype' or 'type', not both")
+            dst_tp = as_cpp_type(dtype)
+            if PyIter_Check(value):
+                # Consume iterators and generators once, without
+                # materializing them as a list
+                self.v = array_from_pyiter(value, dst_tp, -1)
+            elif _is_pep3118_exporter(value):
+                src = array_from_pep3118(value, 0, True)
+                self.v = cpp_empty(src.get_type().with_replaced_dtype(dst_tp))
+                self.v.assign(src)
+            else:
+                dst_tp = cpp_type_for(value).with_replaced_dtype(dst_tp)
+                self.v = cpp_empty(dst_tp)
+                self.v.assign(pyobject_array(value))
+        elif type is None:
+            if (_builtin_type(value) is list or _builtin_type(value) is tuple or
+                    _builtin_type(value) is _builtin_range_type):
+                # Uniform numeric sequences are ingested in a single pass
+                self.v = array_from_pyseq_speculative(value)
+                if not self.v.is_null():
+                    return
+            elif _is_pep3118_exporter(value):
+                # Buffers are copied straight from their memory
+                self.v = array_from_pep3118(value, 0, True)
+                return
+            elif _builtin_type(value) is _np.ndarray and value.dtype.kind == 'O':
+                # Object arrays of strings are checked and copied in one pass
+                self.v = array_from_numpy_array_cast(<PyObject*>value, 0, 1)
+                return
             dst_tp = cpp_type_for(value)
             self.v = cpp_empty(dst_tp)
             self.v.assign(pyobject_array(value))
@@ -161,7 +247,11 @@ cdef class array(object):
                 type = ndt_type(type)
             dst_tp = dynd_ndt_type_to_cpp(type)
             self.v = cpp_empty(dst_tp)
-            self.v.assign(pyobject_array(value))
+            if _is_pep3118_exporter(value):
+                # Convert from the buffer's memory, like without a type
+                self.v.assign(array_from_pep3118(value, 0, True))
+            else:
+                self.v.assign(pyobject_array(value))
 
     property access_flags:
         """
@@ -230,12 +320,63 @@ cdef class array(object):
             import numpy as np
 
             if (tp == np.ndarray):
+                if self.v.get_ndim() > 0:
+                    view = self._numpy_view()
+                    if view is not None:
+                        return view
                 return array_as_numpy(self, bool(True))
         except Exception:
             pass
 
         raise ValueError('could not copy to type ' + tp)
 
+    cdef object _numpy_view(self):
+        # Returns a new NumPy view of the array, or None if it can't be viewed
+        # without a copy. For a read-only array, the view made by the type
+        # analysis is kept as the base of the views handed out, and reused by
+        # later calls for as long as one of them is alive. It is held through
+        # a weak reference, as it keeps this array alive as its base. Callers
+        # get their own ndarray, so reassigning its shape, strides or dtype
+        # doesn't affect the others. Struct dtypes can be changed in place,
+        # so their views aren't reused.
+        cdef object base
+        if self._numpy_view_ref is not None:
+            base = self._numpy_view_ref()
+            if base is not None:
+                return base.view()
+        try:
+            base = array_as_numpy(self, False)
+        except TypeError:
+            return None
+        if (self.v.get_flags() & write_access_flag) or base.dtype.names is not None:
+            return base
+        self._numpy_view_ref = _weakref.ref(base)
+        return base.view()
+
+    property __array_interface__:
+        """
+        a.__array_interface__
+        The NumPy array interface of the array, for the arrays which can be
+        shared with NumPy without a copy.
+        """
+        def __get__(self):
+            view = self._numpy_view()
+            if view is None:
+                raise AttributeError('dynd array of type %s cannot be shared without a copy' % type_of(self))
+            return view.__array_interface__
+
+    property __array_struct__:
+        """
+        a.__array_struct__
+        The NumPy array interface of the array as a C structure, for the
+        arrays which can be shared with NumPy without a copy.
+        """
+        def __get__(self):
+            view = self._numpy_view()
+            if view is None:
+                raise AttributeError('dynd array of type %s cannot be shared without a copy' % type_of(self))
+            return view.__array_struct__
+
     def __contains__(self, x):
         raise NotImplementedError('__contains__ is not yet implemented for nd.array')
 
@@ -597,6 +738,13 @@ cdef _type _type_from_pyarr_wrapper(PyObject *a) nogil:
 
 _register_nd_array_type_deduction(<PyTypeObject*>array, &_type_from_pyarr_wrapper)
 
+cdef bint _is_pep3118_exporter(object obj):
+    # Bytes keep their scalar meaning, and dynd and NumPy arrays and NumPy
+    # scalars have their own conversions which handle more types
+    return (PyObject_CheckBuffer(obj) and not isinstance(obj, bytes) and
+            not isinstance(obj, array) and not isinstance(obj, _np.ndarray) and
+            not isinstance(obj, _np.generic))
+
 cdef _array as_cpp_array(object obj) except *:
     """
     nd.as_cpp_array(obj)
@@ -612,8 +760,8 @@ cdef _array as_cpp_array(object obj) except *:
         return dynd_nd_array_to_cpp(obj)
     elif _builtin_type(obj) is _np.ndarray:
         return array_from_numpy_array_cast(<PyObject*>obj, 0, 0)
-    # elif PyObject_CheckBuffer(obj):
-    #     TODO
+    elif _is_pep3118_exporter(obj):
+        return array_from_pep3118(obj, 0, False)
     cdef _type tp = cpp_type_for(obj)
     cdef _array out = cpp_empty(tp)
     out.assign(pyobject_array(obj))
@@ -724,9 +872,38 @@ def is_f_contiguous(array a):
     """
     return array_is_f_contiguous(a.v)
 
-def as_py(array n):
+def packed_buffers(array a):
+    """
+    nd.packed_buffers(a)
+    Exports a ragged array of type ``[fixed dims *] var * T``
+    as a packed one-dimensional array of its elements and an
+    array of int64 row offsets, both of which support the
+    buffer protocol. This lets C extensions walk ragged data,
+    which has no single PEP 3118 shape, as flat buffers.
+    The leading fixed dimensions are flattened into rows in
+    C order, and row ``r`` is ``data[offsets[r]:offsets[r + 1]]``.
+    When the rows are stored back to back, as they are for
+    arrays built by dynd, ``data`` is a view of the original
+    memory. Otherwise the rows are packed into a copy.
+    Examples
+    --------
+    >>> from dynd import nd
+    >>> data, offsets = nd.packed_buffers(nd.array([[1, 2], [], [3]]))
+    >>> data
+    nd.array([1, 2, 3],
+             type="3 * int32")
+    >>> offsets
+    nd.array([0, 2, 2, 3],
+             type="4 * int64")
+    """
+    cdef array data = array()
+    cdef array offsets = array()
+    array_as_packed_pep3118(a.v, data.v, offsets.v)
+    return data, offsets
+
+def as_py(array n, records='dict'):
     """
-    nd.as_py(n)
+    nd.as_py(n, records='dict')
     Evaluates the dynd array, converting it into native Python types.
     Uniform dimensions convert into Python lists, struct types convert
     into Python dicts, scalars convert into the most appropriate Python
@@ -735,9 +912,10 @@ def as_py(array n):
     ----------
     n : dynd array
         The dynd array to convert into native Python types.
-    tuple : bool
-        If true, produce tuples instead of dicts when converting
-        dynd struct arrays.
+    records : 'dict', 'tuple' or 'namedtuple', optional
+        How to convert dynd struct values. Tuples and namedtuples
+        hold the fields in order, and are cheaper to build than
+        dicts when exporting many records.
     Examples
     --------
     >>> from dynd import nd, ndt
@@ -748,13 +926,115 @@ def as_py(array n):
     >>> nd.as_py(a)
     [1.0, 2.0, 3.0, 4.0]
     """
-    cdef _array res = pyobject_array(None)
-    res.assign(dynd_nd_array_to_cpp(n))
-    return <object> dereference(<PyObject **> res.data())
+    return array_as_py(dynd_nd_array_to_cpp(n), records)
+
+cdef class pyview(object):
+    """
+    nd.pyview(n, records='dict')
+    A read-only Python sequence view of the outermost dimension of
+    the dynd array `n`. Elements are converted into native Python
+    types only when they are indexed or iterated, so handing a large
+    array to pure Python code does not materialize it as nested lists.
+    Elements which still have dimensions are returned as further
+    views. The view holds a reference to `n`, keeping its memory alive.
+    Parameters
+    ----------
+    n : dynd array
+        The dynd array to view. It must have at least one dimension.
+    records : 'dict', 'tuple' or 'namedtuple', optional
+        How to convert dynd struct values, as in nd.as_py.
+    Examples
+    --------
+    >>> from dynd import nd, ndt
+    >>> v = nd.pyview(nd.array([[1, 2], [3, 4, 5]]))
+    >>> len(v)
+    2
+    >>> v[1][-1]
+    5
+    >>> list(v[0])
+    [1, 2]
+    """
+    cdef array arr
+    cdef object records
+
+    def __init__(self, array n not None, records='dict'):
+        if n.v.get_ndim() == 0:
+            raise TypeError('nd.pyview() requires an array with at least '
+                            'one dimension, got type "%s"' % n.type)
+        if records not in ('dict', 'tuple', 'namedtuple'):
+            raise ValueError("nd.pyview() records must be 'dict', 'tuple' "
+                             "or 'namedtuple', got %r" % (records,))
+        self.arr = n
+        self.records = records
+
+    cdef object _wrap(self, array el):
+        if el.v.get_ndim() == 0:
+            return array_as_py(el.v, self.records)
+        return pyview(el, self.records)
+
+    def __len__(self):
+        return self.arr.v.get_dim_size()
+
+    def __getitem__(self, x):
+        cdef intptr_t size
+        cdef intptr_t i
+        cdef array el = array()
+        if isinstance(x, slice):
+            el.v = array_getitem(self.arr.v, x)
+            return pyview(el, self.records)
+        size = self.arr.v.get_dim_size()
+        i = operator.index(x)
+        if i < 0:
+            i += size
+        if i < 0 or i >= size:
+            raise IndexError('nd.pyview index out of range')
+        el.v = array_getitem(self.arr.v, i)
+        return self._wrap(el)
+
+    def __iter__(self):
+        cdef intptr_t size = self.arr.v.get_dim_size()
+        cdef intptr_t i
+        cdef array el
+        for i in range(size):
+            el = array()
+            el.v = array_getitem(self.arr.v, i)
+            yield self._wrap(el)
+
+    def __reversed__(self):
+        cdef intptr_t i
+        cdef array el
+        for i in range(self.arr.v.get_dim_size() - 1, -1, -1):
+            el = array()
+            el.v = array_getitem(self.arr.v, i)
+            yield self._wrap(el)
+
+    def __contains__(self, value):
+        for item in self:
+            if item == value:
+                return True
+        return False
+
+    def index(self, value):
+        for i, item in enumerate(self):
+            if item == value:
+                return i
+        raise ValueError('%r is not in nd.pyview' % (value,))
+
+    def count(self, value):
+        return sum(1 for item in self if item == value)
+
+    def __repr__(self):
+        return 'nd.pyview(%s)' % repr(self.arr)
 
-def view(obj, type=None):
+try:
+    from collections.abc import Sequence as _Sequence
+except ImportError:
+    from collections import Sequence as _Sequence
+_Sequence.register(pyview)
+
+def view(obj, type=None, ticks=False):
     """
-    nd.view(obj, type=None)
+    nd.view(obj, type=None, ticks=False)
     Constructs a dynd array which is a view of the data from
     `obj`. If a type for the returned array is not provided,
     the type of `obj` is used.
@@ -767,7 +1047,14 @@ def view(obj, type=None):
     type : ndt.type, optional
         If provided, requests that the memory of ``obj`` be viewed
         as this type.
+    ticks : bool, optional
+        DyND has no datetime or duration types, so numpy datetime64
+        and timedelta64 data is rejected unless this is True. It is
+        then viewed as the int64 ticks numpy stores, in the unit of
+        the dtype, which the caller has to keep track of.
     """
+    if ticks and isinstance(obj, (_np.ndarray, _np.datetime64, _np.timedelta64)):
+        obj = _datetime_ticks_view(obj)
     if not PyObject_CheckBuffer(obj):
         raise TypeError('Python objects that do not support the buffer '
                         'protocol cannot be viewed as DyND arrays.')
@@ -779,6 +1066,16 @@ def view(obj, type=None):
     cdef _type tp = dynd_ndt_type_to_cpp(_py_type(type))
     return dynd_nd_array_from_cpp(_view(input, tp))
 
+def _datetime_ticks_view(obj):
+    # Views the data of a numpy datetime64 or timedelta64 array or scalar
+    # as int64, keeping its byte order
+    obj = _np.asarray(obj)
+    if obj.dtype.kind not in 'Mm':
+        return obj
+    if _np.datetime_data(obj.dtype)[0] == 'generic':
+        raise TypeError('cannot view numpy %s data with a generic unit as ticks' % obj.dtype)
+    return obj.view(_np.dtype(_np.int64).newbyteorder(obj.dtype.byteorder))
+
 # TODO: The wrappers for zeros, ones, and empty are identical.
 # They should be handled via a macro of some sort (Use Tempita?)
 # Some expansion of the interface on the C++ side is probably necessary
@@ -967,6 +1264,105 @@ def empty(*args, **kwargs):
         return dynd_nd_array_from_cpp(ret)
     raise TypeError('nd.empty() expected at least 1 positional argument, got 0')
 
+def fromiter(it, dtype, count=None):
+    """
+    nd.fromiter(it, dtype, count=None)
+    Constructs a one-dimensional dynd array from an iterable,
+    consuming it exactly once without first materializing
+    it as a Python list.
+    Parameters
+    ----------
+    it : iterable
+        The iterable providing the elements, e.g. a generator
+        or a database cursor.
+    dtype : dynd type
+        The scalar element type of the result.
+    count : int, optional
+        If provided, exactly this many elements are read and the
+        result has a fixed dimension. Otherwise the iterable is read
+        until it is exhausted and the result has a var dimension.
+    Examples
+    --------
+    >>> from dynd import nd, ndt
+    >>> nd.fromiter((x * x for x in range(5)), ndt.int32)
+    nd.array([0, 1, 4, 9, 16],
+             type="var * int32")
+    >>> nd.fromiter(iter(range(10)), ndt.float64, count=3)
+    nd.array([0, 1, 2],
+             type="3 * float64")
+    """
+    cdef array result = array()
+    if count is None:
+        result.v = array_from_pyiter(it, as_cpp_type(dtype), -1)
+    elif count < 0:
+        raise ValueError("nd.fromiter() count must be non-negative")
+    else:
+        result.v = array_from_pyiter(it, as_cpp_type(dtype), count)
+    return result
+
+def datetime_ticks(values, unit='us'):
+    """
+    nd.datetime_ticks(values, unit='us')
+    Converts a sequence of Python datetime values into a one-dimensional
+    int64 array of ticks, the representation numpy uses for datetime64
+    and timedelta64. The result can be viewed by numpy without a copy,
+    as in nd.datetime_ticks(values, 'ns').to(np.ndarray).view('M8[ns]').
+    Parameters
+    ----------
+    values : sequence
+        Either datetime.datetime or datetime.date values, counted from
+        1970-01-01, or datetime.timedelta values. None becomes NaT.
+    unit : str, optional
+        The tick unit, one of 'W', 'D', 'h', 'm', 's', 'ms', 'us' or
+        'ns'. Values are rounded down to a whole tick.
+    Examples
+    --------
+    >>> from dynd import nd
+    >>> from datetime import date, datetime
+    >>> nd.datetime_ticks([date(1970, 1, 2), datetime(1970, 1, 1, 0, 1), None], 's')
+    nd.array([86400, 60, -9223372036854775808],
+             type="3 * int64")
+    """
+    cdef array result = array()
+    result.v = array_from_pydatetimes(values, str(unit).encode('ascii'))
+    return result
+
+def set_copy_threading(grain_size=None, threshold=None, max_threads=None):
+    """
+    nd.set_copy_threading(grain_size=None, threshold=None, max_threads=None)
+    Sets how copies from dynd arrays into new NumPy arrays, as made by
+    a.to(np.ndarray), are split across threads. Copies of
+    data without Python objects release the GIL, and when they are large
+    enough their outer dimension is divided among a pool of threads.
+    Settings which are not provided are left unchanged.
+    Parameters
+    ----------
+    grain_size : int, optional
+        The approximate number of bytes copied by each task.
+    threshold : int, optional
+        Copies smaller than this many bytes run on the calling thread.
+    max_threads : int, optional
+        The maximum number of threads to use, or 0 to use one per core.
+    Returns
+    -------
+    dict
+        The previous settings, which can be passed back as keywords.
+    """
+    cdef intptr_t old_grain_size, old_threshold, old_max_threads
+    get_numpy_copy_threading(old_grain_size, old_threshold, old_max_threads)
+    set_numpy_copy_threading(old_grain_size if grain_size is None else grain_size,
+                             old_threshold if threshold is None else threshold,
+                             old_max_threads if max_threads is None else max_threads)
+    return {'grain_size': old_grain_size, 'threshold': old_threshold,
+            'max_threads': old_max_threads}
+
+def _numpy_type_cache_info():
+    # The counters of this module's dtype/type conversion cache, summed by dynd.config
+    return get_numpy_type_cache_stats()
+
+def _clear_numpy_type_cache():
+    clear_numpy_type_cache()
+
 def old_range(start=None, stop=None, step=None, dtype=None):
     """
     nd.old_range(stop, dtype=None)
@@ -1139,6 +1535,18 @@ cdef extern from 'functional.hpp':
 cdef _callable _functional_apply(_type t, object o) except *:
     return _apply(t, o)
 
+cdef extern from 'functional.hpp':
+    _callable _apply_chunk 'apply_chunk'(_type, object, intptr_t) except +translate_exception
+
+cdef _callable _functional_apply_chunk(_type t, object o, intptr_t chunk_size) except *:
+    return _apply_chunk(t, o, chunk_size)
+
+cdef extern from 'functional.hpp':
+    _callable _from_ufunc 'from_ufunc'(object) except +translate_exception
+
+cdef _callable _functional_from_ufunc(object o) except *:
+    return _from_ufunc(o)
+
 cdef extern from 'assign.hpp':
     void assign_init() except +translate_exception
 
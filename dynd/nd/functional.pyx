@@ -12,6 +12,8 @@ from ..cpp.type cimport make_type
 
 from ..config cimport translate_exception
 from .array cimport _functional_apply as _apply
+from .array cimport _functional_apply_chunk as _apply_chunk
+from .array cimport _functional_from_ufunc as _from_ufunc
 from .callable cimport callable, wrap, dynd_nd_callable_to_cpp
 from ..ndt.type cimport type, as_numba_type, from_numba_type, as_cpp_type
 
@@ -104,9 +106,52 @@ cdef public object _jit(object func, intptr_t nsrc, const _type *src_tp):
     return wrap(_apply_jit(make_type[_callable_type](dst_tp, src_tp_copy),
             library.get_pointer_to_function('single')))
 
-def apply(func = None, jit = _import_numba(), *args, **kwds):
+def apply(func = None, jit = _import_numba(), *args, mode = 'element', chunksize = 4096, **kwds):
+    """
+    apply(func = None, jit = False, *, mode = 'element', chunksize = 4096)
+
+    Returns a callable which calls the Python function ``func``, typed by
+    its annotations. Used as a decorator when ``func`` is omitted.
+
+    Parameters
+    ----------
+    func : function
+        The function to call.
+    jit : bool
+        Whether to compile the function with Numba.
+    mode : 'element' or 'chunk'
+        In 'element' mode the function is called once per element. In
+        'chunk' mode it is called once per strided chunk of up to
+        ``chunksize`` elements, receiving each argument as a
+        one-dimensional nd.array view of the chunk, and must return an
+        array-like of as many results. The return type annotation has to
+        be concrete in this mode.
+    chunksize : int
+        The largest number of elements passed to one call in 'chunk' mode.
+
+    Examples
+    --------
+    >>> from dynd import annotate, nd, ndt
+    >>> import numpy as np
+    >>> @nd.functional.elwise
+    ... @nd.functional.apply(mode = 'chunk')
+    ... @annotate(ndt.float64, ndt.float64)
+    ... def f(x):
+    ...     return np.sqrt(x)
+    >>> f(nd.array([1.0, 4.0, 9.0]))
+    nd.array([1.0, 2.0, 3.0],
+             type="3 * float64")
+    """
     from .. import ndt
+    if mode not in ('element', 'chunk'):
+        raise ValueError("apply mode must be 'element' or 'chunk', got %r" % (mode,))
+
     def make(type tp, func):
+        if mode == 'chunk':
+            if jit:
+                raise ValueError("apply mode 'chunk' does not support jit")
+            return wrap(_apply_chunk(tp.v, func, chunksize))
+
         if jit:
             import numba
             return wrap(_make_callable[apply_jit_dispatch_callable]((<type> tp).v,
@@ -125,6 +170,30 @@ def elwise(func):
 
     return wrap(_elwise((<callable> func).v))
 
+def from_ufunc(ufunc):
+    """
+    from_ufunc(ufunc)
+
+    Returns an elementwise callable which runs the inner loops of a NumPy
+    ufunc, picking the loop whose input types match the arguments. Loops
+    which don't operate on Python objects run without the GIL.
+
+    Parameters
+    ----------
+    ufunc : numpy.ufunc
+        A ufunc with a single output, e.g. ``np.add``.
+
+    Examples
+    --------
+    >>> from dynd import nd
+    >>> import numpy as np
+    >>> add = nd.functional.from_ufunc(np.add)
+    >>> add(nd.array([1.0, 2.0]), nd.array([3.0, 4.0]))
+    nd.array([4.0, 6.0],
+             type="2 * float64")
+    """
+    return wrap(_from_ufunc(ufunc))
+
 def reduction(child):
     if not isinstance(child, callable):
         child = apply(child)
@@ -47,5 +47,102 @@ class TestArrayAsPy(unittest.TestCase):
         a = nd.array(data, type=tp)
         self.assertEqual(nd.as_py(a), data)
 
+    def test_records(self):
+        a = nd.array([(1, 1.5), (2, 3.5)], type='2 * {x:int, y:real}')
+        self.assertEqual(nd.as_py(a, records='dict'), [{'x': 1, 'y': 1.5}, {'x': 2, 'y': 3.5}])
+        self.assertEqual(nd.as_py(a, records='tuple'), [(1, 1.5), (2, 3.5)])
+        b = nd.as_py(a, records='namedtuple')
+        self.assertEqual(b, [(1, 1.5), (2, 3.5)])
+        self.assertEqual(b[1].x, 2)
+        self.assertEqual(b[1].y, 3.5)
+
+        # Nested structs use the same mode
+        a = nd.array((3, (1, 'a')), type='{x:int32, y:{u:int8, v:string}}')
+        self.assertEqual(nd.as_py(a, records='tuple'), (3, (1, 'a')))
+        self.assertEqual(nd.as_py(a), {'x': 3, 'y': {'u': 1, 'v': 'a'}})
+
+        self.assertRaises(ValueError, nd.as_py, a, records='list')
+
+    def test_numeric_dims(self):
+        vals = [0, 1, -5, 100, 127, -128]
+        for tp in [ndt.int8, ndt.int16, ndt.int32, ndt.int64, ndt.float32, ndt.float64]:
+            a = nd.array(vals, type=ndt.make_fixed_dim(len(vals), tp))
+            self.assertEqual(nd.as_py(a), vals)
+        vals = [0, 1, 200, 255]
+        for tp in [ndt.uint8, ndt.uint16, ndt.uint32, ndt.uint64]:
+            a = nd.array(vals, type=ndt.make_fixed_dim(len(vals), tp))
+            self.assertEqual(nd.as_py(a), vals)
+        a = nd.array([True, False, True])
+        self.assertEqual(nd.as_py(a), [True, False, True])
+        a = nd.array([1.5j, -2 + 0.5j])
+        self.assertEqual(nd.as_py(a), [1.5j, -2 + 0.5j])
+
+        # Strided and multidimensional views
+        a = nd.array([[1, 2, 3], [4, 5, 6]], type='2 * 3 * int64')
+        self.assertEqual(nd.as_py(a), [[1, 2, 3], [4, 5, 6]])
+        self.assertEqual(nd.as_py(a[:, 1]), [2, 5])
+        self.assertEqual(nd.as_py(a[:, ::2]), [[1, 3], [4, 6]])
+
+        a = nd.array([[1.5], [2.5, 3.5]], type='2 * var * float64')
+        self.assertEqual(nd.as_py(a), [[1.5], [2.5, 3.5]])
+
+    def test_strings(self):
+        # Mixes pure ASCII values of various lengths with non-ASCII ones
+        vals = [u'', u'a', u'abcdefg', u'abcdefgh', u'abcdefghijklmnopq',
+                u'abcdefgh\u00e9', u'\u00e9', u'x' * 100 + u'\u4e2d', u'x' * 100]
+        a = nd.array(vals, type='var * string')
+        self.assertEqual(nd.as_py(a), vals)
+        self.assertEqual(nd.as_py(a[::-2]), vals[::-2])
+        a = nd.array(vals, type=ndt.make_fixed_dim(len(vals), ndt.make_fixed_string(120, 'utf_8')))
+        self.assertEqual(nd.as_py(a), vals)
+        a = nd.array([u'abc', u'defghijklm'], type='2 * fixed_string[16,"A"]')
+        self.assertEqual(nd.as_py(a), [u'abc', u'defghijklm'])
+
+class TestPyView(unittest.TestCase):
+    def test_sequence(self):
+        if sys.version_info >= (3, 3):
+            from collections.abc import Sequence
+        else:
+            from collections import Sequence
+        a = nd.array([1, 2, 3, 4, 5])
+        v = nd.pyview(a)
+        self.assertTrue(isinstance(v, Sequence))
+        self.assertEqual(len(v), 5)
+        self.assertEqual(v[0], 1)
+        self.assertEqual(v[-1], 5)
+        self.assertRaises(IndexError, lambda: v[5])
+        self.assertRaises(IndexError, lambda: v[-6])
+        self.assertEqual(list(v), [1, 2, 3, 4, 5])
+        self.assertEqual(list(reversed(v)), [5, 4, 3, 2, 1])
+        self.assertEqual(list(v[1:4]), [2, 3, 4])
+        self.assertEqual(list(v[::-2]), [5, 3, 1])
+        self.assertTrue(3 in v)
+        self.assertFalse(7 in v)
+        self.assertEqual(v.index(4), 3)
+        self.assertEqual(v.count(2), 1)
+
+    def test_nested(self):
+        a = nd.array([[1.5], [2.5, 3.5]], type='2 * var * float64')
+        v = nd.pyview(a)
+        self.assertEqual(len(v), 2)
+        self.assertEqual(len(v[1]), 2)
+        self.assertEqual(v[1][-1], 3.5)
+        self.assertEqual([list(x) for x in v], [[1.5], [2.5, 3.5]])
+
+    def test_records(self):
+        a = nd.array([(1, 'a'), (2, 'b')], type='2 * {x:int32, y:string}')
+        self.assertEqual(nd.pyview(a)[1], {'x': 2, 'y': 'b'})
+        self.assertEqual(list(nd.pyview(a, records='tuple')), [(1, 'a'), (2, 'b')])
+        self.assertRaises(ValueError, nd.pyview, a, records='list')
+
+    def test_keeps_array_alive(self):
+        v = nd.pyview(nd.array([[1, 2], [3, 4]]))
+        row = v[1]
+        del v
+        self.assertEqual(list(row), [3, 4])
+
+    def test_scalar(self):
+        self.assertRaises(TypeError, nd.pyview, nd.array(3))
+
 if __name__ == '__main__':
     unittest.main(verbosity=2)
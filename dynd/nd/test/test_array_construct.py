@@ -360,6 +360,50 @@ class TestStructConstruct(unittest.TestCase):
         self.assertRaises(nd.BroadcastError, nd.array,
                         {'x':0,'y':1,'z':2,'w':3}, type='{x:int32, y:int32, z:int32}')
 
+    def test_record_array_chunks(self):
+        # Enough rows to span several column chunks, mixing row kinds
+        n = 1000
+        vals = []
+        for i in range(n):
+            if i % 3 == 0:
+                vals.append((i, 'name%d' % i, i / 2.0))
+            elif i % 3 == 1:
+                vals.append({'id': i, 'name': 'name%d' % i, 'value': i / 2.0})
+            else:
+                vals.append([i, 'name%d' % i, i / 2.0])
+        a = nd.array(vals, type='%d * {id:int64, name:string, value:float64}' % n)
+        self.assertEqual(nd.as_py(a.id), list(range(n)))
+        self.assertEqual(nd.as_py(a.name), ['name%d' % i for i in range(n)])
+        self.assertEqual(nd.as_py(a.value), [i / 2.0 for i in range(n)])
+
+        a = nd.array([(i, -i) for i in range(n)], type='%d * (int32, int32)' % n)
+        self.assertEqual(nd.as_py(a[:,0]), list(range(n)))
+        self.assertEqual(nd.as_py(a[:,1]), [-i for i in range(n)])
+
+    def test_record_array_fresh_keys(self):
+        # Keys that are equal to, but not the same objects as, the field names
+        vals = []
+        for i in range(50):
+            row = {}
+            row[''.join(['i', 'd'])] = i
+            row[''.join(['na', 'me'])] = 'n%d' % i
+            vals.append(row)
+        a = nd.array(vals, type='50 * {id:int32, name:string}')
+        self.assertEqual(nd.as_py(a.id), list(range(50)))
+        self.assertEqual(nd.as_py(a.name), ['n%d' % i for i in range(50)])
+
+        a = nd.array(vals[0], type='{name:string, id:int32}')
+        self.assertEqual(nd.as_py(a), {'id': 0, 'name': 'n0'})
+
+    def test_record_array_bad_row(self):
+        vals = [{'x':i, 'y':i} for i in range(300)]
+        vals[280] = {'x':0, 'z':1}
+        self.assertRaises(nd.BroadcastError, nd.array,
+                        vals, type='300 * {x:int32, y:int32}')
+        vals[280] = (0, 1, 2)
+        self.assertRaises(nd.BroadcastError, nd.array,
+                        vals, type='300 * {x:int32, y:int32}')
+
 #class TestIteratorConstruct(unittest.TestCase):
 #    # Test dynd construction from iterators
 #    #
@@ -719,5 +763,47 @@ class TestOptionArrayConstruct(unittest.TestCase):
 #                                       ('NA', 'NA'),
 #                                       (u'\uc548\ub155', u'\uc548\ub155')])
 
+    def test_option_runs(self):
+        # Runs of NA and valid values, longer than one export chunk,
+        # mixed with strings which take the per-element path
+        vals = [None] * 300 + list(range(500)) + [None, 1, None, None, 2] + [None] * 10
+        a = nd.array(vals, type=ndt.make_fixed_dim(len(vals), ndt.type('?int32')))
+        self.assertEqual(nd.as_py(a), vals)
+        self.assertEqual(nd.as_py(a[::-3]), vals[::-3])
+        a = nd.array([None, '12', 3, 'NA', None, 5], type='6 * ?int32')
+        self.assertEqual(nd.as_py(a), [None, 12, 3, None, None, 5])
+        a = nd.array([[None, 1.5], [], [2.5, None, None]], type='3 * var * ?float64')
+        self.assertEqual(nd.as_py(a), [[None, 1.5], [], [2.5, None, None]])
+
+class TestIterConstruct(unittest.TestCase):
+    def test_fromiter(self):
+        a = nd.fromiter((x * x for x in range(1000)), ndt.int32)
+        self.assertEqual(nd.type_of(a), ndt.type('var * int32'))
+        self.assertEqual(nd.as_py(a), [x * x for x in range(1000)])
+
+    def test_fromiter_empty(self):
+        a = nd.fromiter(iter([]), ndt.float64)
+        self.assertEqual(nd.type_of(a), ndt.type('var * float64'))
+        self.assertEqual(nd.as_py(a), [])
+
+    def test_fromiter_count(self):
+        it = iter(range(10))
+        a = nd.fromiter(it, ndt.float64, count=3)
+        self.assertEqual(nd.type_of(a), ndt.type('3 * float64'))
+        self.assertEqual(nd.as_py(a), [0, 1, 2])
+        # Only the requested elements were consumed
+        self.assertEqual(next(it), 3)
+        self.assertRaises(RuntimeError, nd.fromiter, iter(range(2)), ndt.int32, 5)
+
+    def test_fromiter_string(self):
+        a = nd.fromiter((str(x) for x in range(5)), ndt.string)
+        self.assertEqual(nd.type_of(a), ndt.type('var * string'))
+        self.assertEqual(nd.as_py(a), ['0', '1', '2', '3', '4'])
+
+    def test_array_from_generator(self):
+        a = nd.array((x + 0.5 for x in range(100)), dtype=ndt.float64)
+        self.assertEqual(nd.type_of(a), ndt.type('var * float64'))
+        self.assertEqual(nd.as_py(a), [x + 0.5 for x in range(100)])
+
 if __name__ == '__main__':
     unittest.main(verbosity=2)
@@ -0,0 +1,191 @@
+import sys
+import unittest
+import array
+import mmap
+import struct
+from dynd import nd, ndt
+
+class TestBufferImport(unittest.TestCase):
+    def test_bytearray(self):
+        b = bytearray(b'\x01\x02\x03')
+        a = nd.asarray(b)
+        self.assertEqual(nd.type_of(a), ndt.type('3 * uint8'))
+        self.assertEqual(a.access_flags, 'readwrite')
+        self.assertEqual(nd.as_py(a), [1, 2, 3])
+        # The view shares the memory
+        b[1] = 20
+        self.assertEqual(nd.as_py(a), [1, 20, 3])
+
+    def test_array_array(self):
+        x = array.array('d', [1.5, 2.5, 3.5])
+        a = nd.view(x)
+        self.assertEqual(nd.type_of(a), ndt.type('3 * float64'))
+        self.assertEqual(nd.as_py(a), [1.5, 2.5, 3.5])
+        x[0] = 10
+        self.assertEqual(nd.as_py(a), [10, 2.5, 3.5])
+        x = array.array('i', [1, 2, 3])
+        self.assertEqual(nd.type_of(nd.view(x)), ndt.type('3 * int32'))
+
+    @unittest.skipIf(sys.version_info < (3, 3), 'memoryview.cast requires Python 3.3')
+    def test_memoryview(self):
+        m = memoryview(bytearray(struct.pack('6i', *range(6)))).cast('i', (2, 3))
+        a = nd.asarray(m)
+        self.assertEqual(nd.type_of(a), ndt.type('2 * 3 * int32'))
+        self.assertEqual(nd.as_py(a), [[0, 1, 2], [3, 4, 5]])
+        a = nd.asarray(m[::2])
+        self.assertEqual(nd.as_py(a), [[0, 1, 2]])
+        # A read-only buffer gives a read-only view
+        a = nd.asarray(memoryview(b'abcd').cast('B'))
+        self.assertEqual(a.access_flags, 'readonly')
+
+    @unittest.skipIf(sys.version_info < (3, 3), 'memoryview.cast requires Python 3.3')
+    def test_mmap(self):
+        m = mmap.mmap(-1, 32)
+        m[:16] = struct.pack('2d', 1.25, -3.5)
+        a = nd.asarray(memoryview(m).cast('d'))
+        self.assertEqual(nd.type_of(a), ndt.type('4 * float64'))
+        self.assertEqual(nd.as_py(a)[:2], [1.25, -3.5])
+        del a
+
+    def test_copy(self):
+        b = bytearray(b'\x01\x02')
+        a = nd.array(b)
+        self.assertEqual(nd.type_of(a), ndt.type('2 * uint8'))
+        b[0] = 5
+        self.assertEqual(nd.as_py(a), [1, 2])
+
+    def test_bytes_unchanged(self):
+        # bytes objects stay bytes scalars rather than becoming uint8 arrays
+        self.assertEqual(nd.type_of(nd.array(b'abc')), ndt.bytes)
+
+class TestBufferFormat(unittest.TestCase):
+    @unittest.skipIf(sys.version_info < (3, 3), 'memoryview.cast requires Python 3.3')
+    def test_scalar_formats(self):
+        for fmt, tp in [('b', 'int8'), ('B', 'uint8'), ('h', 'int16'),
+                        ('H', 'uint16'), ('q', 'int64'), ('Q', 'uint64'),
+                        ('f', 'float32'), ('d', 'float64'), ('?', 'bool')]:
+            n = 8 // struct.calcsize(fmt)
+            m = memoryview(bytearray(8)).cast(fmt)
+            self.assertEqual(nd.type_of(nd.asarray(m)),
+                             ndt.make_fixed_dim(n, ndt.type(tp)))
+
+    def test_struct_format(self):
+        try:
+            import numpy as np
+        except ImportError:
+            raise unittest.SkipTest('numpy is needed to export struct buffers')
+
+        # NumPy exports T{...} formats with explicit padding, which a
+        # memoryview passes through to the generic buffer path
+        dt = np.dtype([('x', np.int32), ('y', np.float64), ('z', np.int8, (2,))], align=True)
+        x = np.zeros(2, dtype=dt)
+        x['x'] = [1, 2]
+        x['y'] = [0.5, 1.5]
+        x['z'] = [[3, 4], [5, 6]]
+        a = nd.asarray(memoryview(x))
+        self.assertEqual(nd.type_of(a), ndt.type('2 * {x: int32, y: float64, z: 2 * int8}'))
+        self.assertEqual(nd.as_py(a), [{'x': 1, 'y': 0.5, 'z': [3, 4]},
+                                       {'x': 2, 'y': 1.5, 'z': [5, 6]}])
+
+    def test_non_native_byte_order(self):
+        try:
+            import numpy as np
+        except ImportError:
+            raise unittest.SkipTest('numpy is needed to export swapped buffers')
+
+        x = np.arange(3, dtype=np.dtype(np.int32).newbyteorder())
+        self.assertRaises(RuntimeError, nd.asarray, memoryview(x))
+        # A copy swaps the bytes
+        a = nd.array(memoryview(x))
+        self.assertEqual(nd.type_of(a), ndt.type('3 * int32'))
+        self.assertEqual(nd.as_py(a), [0, 1, 2])
+        x = np.array([1 + 2j], dtype=np.dtype(np.complex128).newbyteorder())
+        self.assertEqual(nd.as_py(nd.array(memoryview(x))), [1 + 2j])
+
+    def test_unaligned_struct(self):
+        try:
+            import numpy as np
+        except ImportError:
+            raise unittest.SkipTest('numpy is needed to export struct buffers')
+
+        # Without padding, the float64 field is at offset 4
+        x = np.zeros(2, dtype=[('x', '<i4'), ('y', '<f8')])
+        x['x'] = [1, 2]
+        x['y'] = [0.5, 1.5]
+        self.assertRaises(RuntimeError, nd.asarray, memoryview(x))
+        a = nd.array(memoryview(x))
+        self.assertEqual(nd.type_of(a), ndt.type('2 * {x: int32, y: float64}'))
+        self.assertEqual(nd.as_py(a), [{'x': 1, 'y': 0.5}, {'x': 2, 'y': 1.5}])
+
+    def test_copy_with_type(self):
+        x = array.array('i', [1, 2, 3])
+        a = nd.array(x, type='3 * float64')
+        self.assertEqual(nd.type_of(a), ndt.type('3 * float64'))
+        self.assertEqual(nd.as_py(a), [1, 2, 3])
+        a = nd.array(x, dtype=ndt.int64)
+        self.assertEqual(nd.type_of(a), ndt.type('3 * int64'))
+        self.assertEqual(nd.as_py(a), [1, 2, 3])
+
+@unittest.skipIf(sys.version_info < (3, 3), 'memoryview suboffsets require Python 3.3')
+class TestBufferExportIndirect(unittest.TestCase):
+    def test_var_dim(self):
+        a = nd.array([[1, 2, 3], [4, 5, 6]], type='2 * var * int32')
+        m = memoryview(a)
+        self.assertEqual(m.shape, (2, 3))
+        self.assertEqual(m.suboffsets, (0, -1))
+        self.assertEqual(m.tolist(), [[1, 2, 3], [4, 5, 6]])
+
+    def test_outer_var_dim(self):
+        a = nd.array([[1.5, 2.5], [3.5, 4.5]], type='var * 2 * float64')
+        m = memoryview(a)
+        self.assertEqual(m.shape, (2, 2))
+        self.assertEqual(m.tolist(), [[1.5, 2.5], [3.5, 4.5]])
+
+    def test_nested_var_dims(self):
+        a = nd.array([[[1], [2]], [[3], [4]]], type='2 * var * var * int64')
+        m = memoryview(a)
+        self.assertEqual(m.shape, (2, 2, 1))
+        self.assertEqual(m.suboffsets, (0, 0, -1))
+        self.assertEqual(m.tolist(), [[[1], [2]], [[3], [4]]])
+
+    def test_ragged_raises(self):
+        a = nd.array([[1, 2, 3], [4]], type='2 * var * int32')
+        self.assertRaises(BufferError, memoryview, a)
+
+class TestPackedBuffers(unittest.TestCase):
+    def test_packed(self):
+        a = nd.array([[1, 2, 3], [], [4, 5]], type='3 * var * int32')
+        data, offsets = nd.packed_buffers(a)
+        self.assertEqual(nd.type_of(data), ndt.type('5 * int32'))
+        self.assertEqual(nd.as_py(data), [1, 2, 3, 4, 5])
+        self.assertEqual(nd.type_of(offsets), ndt.type('4 * int64'))
+        self.assertEqual(nd.as_py(offsets), [0, 3, 3, 5])
+        # The data shares memory with the ragged array
+        data[3] = 40
+        self.assertEqual(nd.as_py(a), [[1, 2, 3], [], [40, 5]])
+
+    def test_leading_fixed_dims(self):
+        a = nd.array([[[1], [2, 3]], [[], [4]]], type='2 * 2 * var * int16')
+        data, offsets = nd.packed_buffers(a)
+        self.assertEqual(nd.as_py(data), [1, 2, 3, 4])
+        self.assertEqual(nd.as_py(offsets), [0, 1, 3, 3, 4])
+
+    def test_subarray_elements(self):
+        a = nd.array([[[1, 2]], [[3, 4], [5, 6]]], type='2 * var * 2 * float32')
+        data, offsets = nd.packed_buffers(a)
+        self.assertEqual(nd.type_of(data), ndt.type('3 * 2 * float32'))
+        self.assertEqual(nd.as_py(data), [[1, 2], [3, 4], [5, 6]])
+        self.assertEqual(nd.as_py(offsets), [0, 1, 3])
+
+    def test_single_row(self):
+        data, offsets = nd.packed_buffers(nd.array([1, 2], type='var * int32'))
+        self.assertEqual(nd.as_py(data), [1, 2])
+        self.assertEqual(nd.as_py(offsets), [0, 2])
+
+    def test_not_ragged(self):
+        self.assertRaises(TypeError, nd.packed_buffers, nd.array([[1, 2], [3, 4]]))
+        self.assertRaises(TypeError, nd.packed_buffers,
+                          nd.array([[[1]]], type='var * var * 1 * int32'))
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
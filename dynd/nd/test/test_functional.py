@@ -5,6 +5,8 @@ else:
     import unittest2 as unittest
 
 from dynd import annotate, nd, ndt
+import numpy as np
+from numpy.testing import assert_equal
 
 @unittest.skip('Test disabled since callables were reworked')
 class TestApply(unittest.TestCase):
@@ -76,6 +78,91 @@ class TestReduction(unittest.TestCase):
         self.assertEqual(3, f([1, 2, 3]))
         self.assertEqual(6, f([[1, 2, 3], [4, 5, 6]]))
 
+class TestApplyChunk(unittest.TestCase):
+    def test_unary(self):
+        sizes = []
+
+        @nd.functional.elwise
+        @nd.functional.apply(mode = 'chunk', chunksize = 1000)
+        @annotate(ndt.float64, ndt.float64)
+        def f(x):
+            sizes.append(len(x))
+            return np.sqrt(x.to(np.ndarray))
+
+        a = np.arange(10000, dtype=np.float64)
+        assert_equal(f(nd.asarray(a)).to(np.ndarray), np.sqrt(a))
+        self.assertEqual(sum(sizes), 10000)
+        self.assertLessEqual(max(sizes), 1000)
+        self.assertLessEqual(len(sizes), 10)
+
+    def test_binary(self):
+        @nd.functional.elwise
+        @nd.functional.apply(mode = 'chunk')
+        @annotate(ndt.int64, ndt.int32, ndt.int32)
+        def f(x, y):
+            return x.to(np.ndarray).astype(np.int64) * y.to(np.ndarray)
+
+        a = nd.array([[1, 2, 3], [4, 5, 6]], type='2 * 3 * int32')
+        b = nd.array([10, 20, 30], type='3 * int32')
+        self.assertEqual(nd.as_py(f(a, b)), [[10, 40, 90], [40, 100, 180]])
+
+    def test_wrong_result_size(self):
+        @nd.functional.elwise
+        @nd.functional.apply(mode = 'chunk')
+        @annotate(ndt.float64, ndt.float64)
+        def f(x):
+            return x.to(np.ndarray)[:1]
+
+        self.assertRaises(ValueError, f, nd.array([1.0, 2.0, 3.0]))
+
+    def test_bad_arguments(self):
+        def f(x):
+            return x
+
+        self.assertRaises(ValueError, nd.functional.apply, f, mode = 'chunk')
+        self.assertRaises(ValueError, nd.functional.apply, annotate(ndt.int32, ndt.int32)(f), mode = 'vector')
+        self.assertRaises(ValueError, nd.functional.apply, annotate(ndt.int32, ndt.int32)(f), mode = 'chunk',
+                          chunksize = 0)
+
+class TestFromUfunc(unittest.TestCase):
+    def test_binary(self):
+        add = nd.functional.from_ufunc(np.add)
+        a = add(nd.array([1.5, 2.5, 3.5]), nd.array([1.0, 2.0, 3.0]))
+        self.assertEqual(nd.type_of(a), ndt.type('3 * float64'))
+        self.assertEqual(nd.as_py(a), [2.5, 4.5, 6.5])
+        a = add(nd.array([[1, 2], [3, 4]], type='2 * 2 * int32'),
+                nd.array([10, 20], type='2 * int32'))
+        self.assertEqual(nd.type_of(a), ndt.type('2 * 2 * int32'))
+        self.assertEqual(nd.as_py(a), [[11, 22], [13, 24]])
+
+    def test_unary(self):
+        sqrt = nd.functional.from_ufunc(np.sqrt)
+        a = sqrt(nd.array([1.0, 4.0, 9.0]))
+        self.assertEqual(nd.as_py(a), [1.0, 2.0, 3.0])
+
+    def test_large(self):
+        # Large enough to release the GIL and run in several chunks
+        multiply = nd.functional.from_ufunc(np.multiply)
+        x = np.arange(100000, dtype=np.float64)
+        a = multiply(nd.array(x), nd.array(x))
+        assert_equal(a.to(np.ndarray), x * x)
+        a = multiply(nd.array(x[::3]), nd.array(x[1::3]))
+        assert_equal(a.to(np.ndarray), x[::3] * x[1::3])
+
+    def test_object(self):
+        # Object arrays of strings deduce a string type, so ask for pyobject
+        add = nd.functional.from_ufunc(np.add)
+        a = add(nd.array(np.array(['a', 'b'], dtype=object), type='2 * pyobject'),
+                nd.array(np.array(['x', 'y'], dtype=object), type='2 * pyobject'))
+        self.assertEqual(nd.as_py(a), ['ax', 'by'])
+
+    def test_errors(self):
+        add = nd.functional.from_ufunc(np.add)
+        self.assertRaises(TypeError, add, nd.array([1], type='1 * int32'),
+                          nd.array([1.0], type='1 * float64'))
+        self.assertRaises(TypeError, nd.functional.from_ufunc, len)
+        self.assertRaises(ValueError, nd.functional.from_ufunc, np.modf)
+
 """
 def multigen(func):
     return lambda x: x
@@ -408,6 +408,59 @@ class TestAsNumpy(unittest.TestCase):
         self.assertEqual(b.dtype, np.dtype('int32'))
         self.assertEqual(b.tolist(), [1, 3, 5])
 
+    def test_threaded_copy(self):
+        # utf8 fixed strings have no numpy view, so they are copied
+        vals = [[u'r%d' % i, u'c\u00e9%d' % i] for i in range(1000)]
+        a = nd.array(vals, type='1000 * 2 * fixed_string[8]')
+        old = nd.set_copy_threading(grain_size=64, threshold=0, max_threads=4)
+        try:
+            b = a.to(np.ndarray)
+        finally:
+            nd.set_copy_threading(**old)
+        self.assertEqual(b.tolist(), vals)
+        self.assertEqual(a.to(np.ndarray).tolist(), vals)
+        self.assertRaises(ValueError, nd.set_copy_threading, grain_size=0)
+
+    def test_array_interface(self):
+        a = nd.array([[1, 2, 3], [4, 5, 6]], type='2 * 3 * int32')
+        info = a.__array_interface__
+        self.assertEqual(info['shape'], (2, 3))
+        self.assertEqual(np.dtype(info['typestr']), np.dtype('int32'))
+
+        class Interface(object):
+            pass
+        for name in ['__array_interface__', '__array_struct__']:
+            obj = Interface()
+            setattr(obj, name, getattr(a, name))
+            b = np.asarray(obj)
+            self.assertEqual(b.tolist(), [[1, 2, 3], [4, 5, 6]])
+            # The NumPy array shares the dynd data
+            b[0, 0] = 10
+            self.assertEqual(nd.as_py(a)[0][0], 10)
+            b[0, 0] = 1
+        # Arrays that need a copy don't provide the interface
+        a = nd.array([u'a', u'b'])
+        self.assertFalse(hasattr(a, '__array_interface__'))
+        self.assertFalse(hasattr(a, '__array_struct__'))
+
+    def test_cached_view(self):
+        a = np.arange(6, dtype=np.float64)
+        a.flags.writeable = False
+        b = nd.view(a)
+        c = b.to(np.ndarray)
+        d = b.to(np.ndarray)
+        # The views share the analysis, but not the ndarray
+        self.assertTrue(d.base is c.base)
+        self.assertFalse(d is c)
+        c.shape = (2, 3)
+        c.dtype = np.int64
+        self.assertEqual(d.shape, (6,))
+        self.assertEqual(d.dtype, np.float64)
+        self.assertEqual(b.to(np.ndarray).tolist(), a.tolist())
+        # Writable arrays get a new view each time
+        b = nd.array([1, 2, 3])
+        self.assertFalse(b.to(np.ndarray) is b.to(np.ndarray))
+
     def test_fixed_dim_via_pep3118(self):
         a = nd.array([1, 3, 5], type='3 * int32')
         b = np.asarray(a)
@@ -629,6 +682,186 @@ class TestNumpyScalarInterop(unittest.TestCase):
                                             ('z', 'float64')], align=True))
         self.assertEqual(b.tolist(), [(1, "testing", 1.5), (10, "abc", 2)])
 
+class TestNumpyScalarList(unittest.TestCase):
+    def test_integer_scalars(self):
+        vals = list(np.arange(5, dtype=np.int16))
+        a = nd.array(vals, type='5 * int32')
+        self.assertEqual(nd.as_py(a), [0, 1, 2, 3, 4])
+        a = nd.array(vals, type='5 * uint8')
+        self.assertEqual(nd.as_py(a), [0, 1, 2, 3, 4])
+        a = nd.array(vals, type='5 * float32')
+        self.assertEqual(nd.as_py(a), [0.0, 1.0, 2.0, 3.0, 4.0])
+        a = nd.array([np.uint64(2**63 + 1)], type='1 * uint64')
+        self.assertEqual(nd.as_py(a), [2**63 + 1])
+
+    def test_mixed_scalars(self):
+        vals = [np.int8(-3), np.uint32(7), np.float32(2.5), np.bool_(True)]
+        a = nd.array(vals, type='4 * float64')
+        self.assertEqual(nd.as_py(a), [-3.0, 7.0, 2.5, 1.0])
+        a = nd.array(vals, type='4 * complex[float64]')
+        self.assertEqual(nd.as_py(a), [-3.0, 7.0, 2.5, 1.0])
+
+    def test_bool_scalars(self):
+        a = nd.array([np.bool_(True), np.bool_(False), np.int8(1)], type='3 * bool')
+        self.assertEqual(nd.as_py(a), [True, False, True])
+
+    def test_checked_fallback(self):
+        # Values the destination can't hold still go through the checked assignment
+        self.assertRaises(OverflowError, nd.array, [np.int32(300)], type='1 * uint8')
+        self.assertRaises(OverflowError, nd.array, [np.int64(-1)], type='1 * uint64')
+        self.assertRaises((ValueError, RuntimeError), nd.array, [np.float32(2.5)], type='1 * int32')
+        a = nd.array([np.float64(2.0)], type='1 * int32')
+        self.assertEqual(nd.as_py(a), [2])
+
+class TestCopyFromNumpy(unittest.TestCase):
+    def test_contiguous(self):
+        a = np.arange(24, dtype=np.float64).reshape(2, 3, 4)
+        b = nd.array(a, type='2 * 3 * 4 * float64')
+        self.assertEqual(nd.as_py(b), a.tolist())
+
+    def test_strided(self):
+        a = np.arange(60, dtype=np.int32).reshape(6, 10)
+        for src in [a[::2], a[:, ::3], a[::-1, 1::2], a.T, np.asfortranarray(a)]:
+            b = nd.array(src, type=ndt.make_fixed_dim(src.shape, ndt.int32))
+            self.assertEqual(nd.as_py(b), src.tolist())
+        a = np.arange(10, dtype=np.complex128) * (1 + 2j)
+        b = nd.array(a[::3], type='4 * complex[float64]')
+        self.assertEqual(nd.as_py(b), a[::3].tolist())
+
+    def test_byteswapped(self):
+        a = np.arange(12, dtype=np.int32).reshape(3, 4)
+        b = nd.array(a.astype(a.dtype.newbyteorder()), type='3 * 4 * int32')
+        self.assertEqual(nd.as_py(b), a.byteswap().tolist())
+
+    def test_convert(self):
+        a = np.arange(6, dtype=np.int16).reshape(2, 3)
+        b = nd.array(a, type='2 * 3 * float64')
+        self.assertEqual(nd.as_py(b), a.tolist())
+
+    def test_struct(self):
+        a = np.array([(1, 2.5), (3, 4.5)], dtype=[('x', np.int64), ('y', np.float64)])
+        b = nd.array(a, type='2 * {y: float64, x: int64}')
+        self.assertEqual(nd.as_py(b), [{'y': 2.5, 'x': 1}, {'y': 4.5, 'x': 3}])
+        b = nd.array(a[::-1], type='2 * (int64, float64)')
+        self.assertEqual(nd.as_py(b, records='tuple'), [(3, 4.5), (1, 2.5)])
+
+    def test_object(self):
+        a = np.array([u'a', u'bc', u'def'], dtype=object)
+        b = nd.array(a[::2], type='2 * string')
+        self.assertEqual(nd.as_py(b), [u'a', u'def'])
+
+    def test_object_strings(self):
+        a = np.array([u'a', u'bc', u'\xe9t\xe9', u''], dtype=object)
+        b = nd.array(a)
+        self.assertEqual(nd.type_of(b), ndt.type('4 * string'))
+        self.assertEqual(nd.as_py(b), a.tolist())
+        b = nd.array(a.reshape(2, 2).T)
+        self.assertEqual(nd.type_of(b), ndt.type('2 * 2 * string'))
+        self.assertEqual(nd.as_py(b), a.reshape(2, 2).T.tolist())
+        # None becomes NA
+        a = np.array([None, u'a', None, None, u'bc', None], dtype=object)
+        b = nd.array(a)
+        self.assertEqual(nd.type_of(b), ndt.type('6 * ?string'))
+        self.assertEqual(nd.as_py(b), a.tolist())
+        b = nd.array(a, type='6 * ?string')
+        self.assertEqual(nd.as_py(b), a.tolist())
+        self.assertEqual(nd.type_of(nd.array(np.array([], dtype=object))), ndt.type('0 * string'))
+
+    def test_object_strings_copy(self):
+        # nd.array takes the single pass copy, which owns its strings
+        a = np.array([u'x', u'yz', u'\u2603'] * 1000, dtype=object)
+        b = nd.array(a)
+        a[0] = u'changed'
+        self.assertEqual(nd.as_py(b[0]), u'x')
+        self.assertEqual(nd.as_py(b), [u'x', u'yz', u'\u2603'] * 1000)
+        # Other objects aren't deduced as strings
+        self.assertRaises(TypeError, nd.array, np.array([u'a', 1], dtype=object))
+        self.assertRaises(TypeError, nd.array, np.array([None, None], dtype=object))
+
+class TestNumpyTypeCache(unittest.TestCase):
+    def test_struct_cache(self):
+        from dynd import config
+        config.clear_numpy_type_cache()
+        dt = np.dtype([('x', np.int32), ('y', np.float64)], align=True)
+        a = np.zeros(3, dtype=dt)
+        self.assertEqual(nd.type_of(nd.array(a)), ndt.type('3 * {x: int32, y: float64}'))
+        misses = config.numpy_type_cache_info()['dtype_misses']
+        for i in range(4):
+            b = nd.array(a)
+            self.assertEqual(nd.type_of(b), ndt.type('3 * {x: int32, y: float64}'))
+        info = config.numpy_type_cache_info()
+        self.assertEqual(info['dtype_misses'], misses)
+        self.assertTrue(info['dtype_hits'] >= 4)
+        # Renaming the fields of the dtype isn't masked by the cache
+        a.dtype.names = ('p', 'q')
+        self.assertEqual(nd.type_of(nd.array(a)), ndt.type('3 * {p: int32, q: float64}'))
+        config.clear_numpy_type_cache()
+        self.assertEqual(config.numpy_type_cache_info(),
+                         {'dtype_hits': 0, 'dtype_misses': 0, 'type_hits': 0, 'type_misses': 0, 'size': 0})
+
+    def test_string_cache(self):
+        from dynd import config
+        config.clear_numpy_type_cache()
+        a = nd.array([u'a', u'bc'])
+        b = a.to(np.ndarray)
+        c = a.to(np.ndarray)
+        self.assertEqual(b.dtype, c.dtype)
+        self.assertEqual(c.tolist(), [u'a', u'bc'])
+        self.assertTrue(config.numpy_type_cache_info()['type_hits'] >= 1)
+
+    def test_struct_names_not_shared(self):
+        from dynd import config
+        config.clear_numpy_type_cache()
+        a = nd.array([{'x': u'a', 'y': 1}], type='1 * {x: string, y: int32}')
+        b = a.to(np.ndarray)
+        b.dtype.names = ('p', 'q')
+        # Renaming the fields of one export doesn't change later ones
+        c = a.to(np.ndarray)
+        self.assertEqual(c.dtype.names, ('x', 'y'))
+        self.assertTrue(config.numpy_type_cache_info()['type_hits'] >= 1)
+
+class TestDatetimeInterop(unittest.TestCase):
+    def test_datetime64_view(self):
+        a = np.array(['2000-01-01T00:00:00', 'NaT', '1969-12-31T23:59:59'], dtype='M8[ns]')
+        # The unit would be lost, so the ticks have to be asked for
+        self.assertRaises(TypeError, nd.view, a)
+        self.assertRaises(TypeError, nd.array, a)
+        b = nd.view(a, ticks=True)
+        self.assertEqual(nd.type_of(b), ndt.type('3 * int64'))
+        self.assertEqual(nd.as_py(b), a.view(np.int64).tolist())
+        # The view shares the numpy data
+        a[0] = np.datetime64('2001-01-01T00:00:00', 'ns')
+        self.assertEqual(nd.as_py(b)[0], a.view(np.int64)[0])
+        b = nd.array(nd.view(a[::2], ticks=True))
+        self.assertEqual(nd.as_py(b), a[::2].view(np.int64).tolist())
+
+    def test_timedelta64_view(self):
+        a = np.array([1, -5, 3600], dtype='m8[s]')
+        self.assertRaises(TypeError, nd.view, a)
+        b = nd.view(a, ticks=True)
+        self.assertEqual(nd.type_of(b), ndt.type('3 * int64'))
+        self.assertEqual(nd.as_py(b), [1, -5, 3600])
+        self.assertEqual(nd.as_py(nd.view(np.timedelta64(90, 'm'), ticks=True)), 90)
+        self.assertRaises(TypeError, nd.view, np.array([1, 2], dtype='m8'), ticks=True)
+
+    def test_datetime_ticks(self):
+        from datetime import date, datetime, timedelta
+        values = [datetime(2000, 1, 1, 12, 30, 15, 250), date(1969, 7, 20), None,
+                  datetime(1700, 3, 1, 23, 59, 59, 999999)]
+        for unit in ['D', 'h', 's', 'ms', 'us', 'ns']:
+            b = nd.datetime_ticks(values, unit)
+            self.assertEqual(nd.type_of(b), ndt.type('4 * int64'))
+            expected = np.array(values, dtype='M8[%s]' % unit)
+            assert_equal(b.to(np.ndarray).view('M8[%s]' % unit), expected)
+        deltas = [timedelta(days=-1, microseconds=1), timedelta(hours=5), None]
+        assert_equal(nd.datetime_ticks(deltas, 's').to(np.ndarray).view('m8[s]'),
+                     np.array(deltas, dtype='m8[s]'))
+        self.assertEqual(nd.as_py(nd.datetime_ticks([], 'us')), [])
+        self.assertRaises(ValueError, nd.datetime_ticks, [date(2000, 1, 1), timedelta(1)])
+        self.assertRaises(ValueError, nd.datetime_ticks, [1], 'us')
+        self.assertRaises(ValueError, nd.datetime_ticks, [date(2000, 1, 1)], 'fortnight')
+        self.assertRaises(OverflowError, nd.datetime_ticks, [date(3000, 1, 1)], 'ns')
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=2)
@@ -41,6 +41,82 @@ class TestPythonList(unittest.TestCase):
         self.assertEqual(a.shape, (2,3))
         self.assertEqual(nd.as_py(a), lst)
 
+    def test_int64_bulk(self):
+        # Values beyond 30 bits aren't stored compactly by Python,
+        # and must still be ingested as int64
+        lst = [(-1) ** i * (2**40 + i) for i in range(1000)]
+        lst[500] = True
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.int64)
+        self.assertEqual(a.shape, (1000,))
+        self.assertEqual(nd.as_py(a), [int(x) for x in lst])
+
+        lst = [[2**40, -2**40, 7], [2**62, -2**63, 2**40 + 1]]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.int64)
+        self.assertEqual(nd.as_py(a), lst)
+
+    def test_big_int(self):
+        lst = [0, 2**63, 2**64 - 1]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.uint64)
+        self.assertEqual(nd.as_py(a), lst)
+
+        lst = [-1, 2**63]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.int128)
+        self.assertEqual(nd.as_py(a), lst)
+
+        lst = [[2**63, 5], [-2**100, 2**127 - 1]]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.int128)
+        self.assertEqual(nd.as_py(a), lst)
+
+        a = nd.array(2**64)
+        self.assertEqual(nd.type_of(a), ndt.int128)
+        self.assertEqual(nd.as_py(a), 2**64)
+
+        self.assertRaises(OverflowError, nd.array, [1, 2**127])
+
+    def test_int128_bounds(self):
+        # Deduced and explicitly typed int128 agree on the range
+        lst = [-2**127, 2**127 - 1, -2**64, 2**64]
+        for a in [nd.array(lst), nd.array(lst, type='4 * int128')]:
+            self.assertEqual(nd.dtype_of(a), ndt.int128)
+            self.assertEqual(nd.as_py(a), lst)
+
+        for value in [-2**127 - 1, 2**127]:
+            self.assertRaises(OverflowError, nd.array, [0, value])
+            self.assertRaises(OverflowError, nd.array, [0, value], type='2 * int128')
+
+    def test_big_int_promotion(self):
+        # Big ints appearing after many small ones widen the values already ingested
+        lst = list(range(1000)) + [2**63]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.uint64)
+        self.assertEqual(nd.as_py(a), lst)
+
+        lst = list(range(-500, 500)) + [2**63] + list(range(1000))
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.int128)
+        self.assertEqual(nd.as_py(a), lst)
+
+        lst = [2**63 + i for i in range(1000)] + [-1] + list(range(1000))
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.int128)
+        self.assertEqual(nd.as_py(a), lst)
+
+        lst = [[2**64, 1], [-3, 2**70]]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.int128)
+        self.assertEqual(nd.as_py(a), lst)
+
+        # Big ints mixed with floats still go through the general path
+        lst = [1.5, 2**63, 3]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.float64)
+        self.assertEqual(nd.as_py(a), [1.5, float(2**63), 3.0])
+
     def test_float64(self):
         lst = [0, 100.0, 1e25, -1000000000]
         a = nd.array(lst)
@@ -54,6 +130,139 @@ class TestPythonList(unittest.TestCase):
         self.assertEqual(a.shape, (2,3))
         self.assertEqual(nd.as_py(a), lst)
 
+    def test_promotion(self):
+        # The element type guessed from the start of the list
+        # must be widened when a later element needs it
+        lst = [True, False, 3]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.int32)
+        self.assertEqual(nd.as_py(a), [1, 0, 3])
+
+        lst = [[1, 2], [3, 20000000000], [5, 6]]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.int64)
+        self.assertEqual(a.shape, (3,2))
+        self.assertEqual(nd.as_py(a), lst)
+
+        lst = [[1, -2, 3], [4, 5, 6.5]]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.float64)
+        self.assertEqual(a.shape, (2,3))
+        self.assertEqual(nd.as_py(a), lst)
+
+    def test_ragged_fallback(self):
+        lst = [[1, 2], [3], [4, 5.5, 6]]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.float64)
+        self.assertEqual(nd.as_py(a), lst)
+
+    def test_tuple(self):
+        a = nd.array(((1, 2), (3, 4), (5, 6)))
+        self.assertEqual(nd.dtype_of(a), ndt.int32)
+        self.assertEqual(a.shape, (3,2))
+        self.assertEqual(nd.as_py(a), [[1, 2], [3, 4], [5, 6]])
+
+        a = nd.array([(1.5, 2), (3, 4)])
+        self.assertEqual(nd.dtype_of(a), ndt.float64)
+        self.assertEqual(a.shape, (2,2))
+        self.assertEqual(nd.as_py(a), [[1.5, 2], [3, 4]])
+
+    def test_tuple_record(self):
+        # Tuples mixing kinds of values are records, not dimensions
+        lst = [(1, u'a'), (2, u'b')]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.type('(int32, string)'))
+        self.assertEqual(a.shape, (2,))
+        self.assertEqual(nd.as_py(a), lst)
+
+        lst = [(1, u'a'), (2**40, u'b')]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.type('(int64, string)'))
+        self.assertEqual(nd.as_py(a), lst)
+
+        a = nd.array((1.5, u'x'))
+        self.assertEqual(nd.type_of(a), ndt.type('(float64, string)'))
+        self.assertEqual(nd.as_py(a), (1.5, u'x'))
+
+        # Tuples of one kind of value are still dimensions
+        a = nd.array([(u'a', u'b'), (u'c', u'd')])
+        self.assertEqual(nd.dtype_of(a), ndt.string)
+        self.assertEqual(a.shape, (2,2))
+
+        # Records with different numbers of fields don't promote
+        self.assertRaises(TypeError, nd.array, [(1, u'a'), (2, u'b', 3)])
+
+    def test_namedtuple_record(self):
+        from collections import namedtuple
+        Point = namedtuple('Point', ['x', 'y'])
+        a = nd.array([Point(1, 2), Point(3, 4)])
+        self.assertEqual(nd.dtype_of(a), ndt.type('(int32, int32)'))
+        self.assertEqual(a.shape, (2,))
+        self.assertEqual(nd.as_py(a), [(1, 2), (3, 4)])
+
+    def test_range(self):
+        a = nd.array(range(10))
+        self.assertEqual(nd.dtype_of(a), ndt.int32)
+        self.assertEqual(a.shape, (10,))
+        self.assertEqual(nd.as_py(a), list(range(10)))
+
+    def test_string(self):
+        lst = [u'a', u'bc', u'\u00e9t\u00e9', u'\uc548\ub155']
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.string)
+        self.assertEqual(a.shape, (4,))
+        self.assertEqual(nd.as_py(a), lst)
+
+        lst = [[u'a', u'b'], [u'c', u'd']]
+        a = nd.array(lst)
+        self.assertEqual(nd.dtype_of(a), ndt.string)
+        self.assertEqual(a.shape, (2,2))
+        self.assertEqual(nd.as_py(a), lst)
+
+    def test_encode_auto(self):
+        lst = [u'red', u'green', u'red', u'blue'] * 10
+        a = nd.array(lst, encode='auto')
+        self.assertEqual(nd.dtype_of(a).type_id, 'categorical')
+        self.assertEqual(a.shape, (40,))
+        self.assertEqual(nd.as_py(a), lst)
+
+        # Mostly distinct values are not worth encoding
+        lst = [u'a', u'b', u'c', u'd']
+        a = nd.array(lst, encode='auto')
+        self.assertEqual(nd.dtype_of(a), ndt.string)
+        self.assertEqual(nd.as_py(a), lst)
+
+        # Non-string data is unaffected
+        a = nd.array([1, 2, 3], encode='auto')
+        self.assertEqual(nd.dtype_of(a), ndt.int32)
+
+        self.assertRaises(ValueError, nd.array, [u'a'], encode='dict')
+
+    def test_encode_auto_export(self):
+        # Categorical values export as their categories, element by element
+        lst = [u'x', u'y', u'x', u'x', u'z', u'y'] * 5
+        a = nd.array(lst, encode='auto')
+        self.assertEqual(nd.dtype_of(a).type_id, 'categorical')
+        self.assertEqual(nd.as_py(a), lst)
+        self.assertEqual(nd.as_py(a[2:5]), lst[2:5])
+        self.assertEqual(nd.as_py(a[4]), u'z')
+
+        lst = [[u'red', u'red'], [u'blue', u'red'], [u'red', u'blue']]
+        a = nd.array(lst, encode='auto')
+        self.assertEqual(nd.dtype_of(a).type_id, 'categorical')
+        self.assertEqual(a.shape, (3,2))
+        self.assertEqual(nd.as_py(a), lst)
+
+    def test_encode_auto_sequences(self):
+        lst = [u'red', u'green', u'red', u'red'] * 10
+        for value in [iter(lst), (s for s in lst), nd.pyview(nd.array(lst))]:
+            a = nd.array(value, encode='auto')
+            self.assertEqual(nd.dtype_of(a).type_id, 'categorical')
+            self.assertEqual(nd.as_py(a), lst)
+
+        self.assertRaises(TypeError, nd.array, u'red', encode='auto')
+        self.assertRaises(TypeError, nd.array, 3, encode='auto')
+
     """
     def test_float64(self):
         lst = [0, 100.0, 1e25, -1000000000+3j]
@@ -83,10 +83,20 @@ cdef extern from "numpy_type_interop.hpp" namespace "pydynd":
     # Technically returns a bool.
     # Rely on an implicit cast to convert it to a bint for Cython.
     bint is_numpy_dtype(PyObject*)
+    cdef struct numpy_type_cache_stats:
+        intptr_t dtype_hits
+        intptr_t dtype_misses
+        intptr_t type_hits
+        intptr_t type_misses
+        intptr_t size
+    numpy_type_cache_stats get_numpy_type_cache_stats()
+    void clear_numpy_type_cache()
 
 cdef extern from "type_deduction.hpp" namespace 'pydynd':
     void register_nd_array_type_deduction(PyTypeObject *array_type, _type (*get_type)(PyObject *))
     _type xtype_for_prefix(object) except +translate_exception
+    bint is_pytuple_record(object) except +translate_exception
+    _type pytuple_record_type_for(object) except +translate_exception
 
 cdef extern from 'init.hpp' namespace 'pydynd':
     void numpy_interop_init() except *
@@ -415,6 +425,13 @@ cpdef type astype(object o):
         return o
     return wrap(as_cpp_type(o))
 
+def _numpy_type_cache_info():
+    # The counters of this module's dtype/type conversion cache, summed by dynd.config
+    return get_numpy_type_cache_stats()
+
+def _clear_numpy_type_cache():
+    clear_numpy_type_cache()
+
 # Disabled until dynd_make_categorical_type takes a std::vector<T>
 '''
 def make_categorical(values):
@@ -733,7 +750,10 @@ cdef _type cpp_type_for(object obj) except *:
     cdef _type tp = xtype_for_prefix(obj)
     if (not tp.is_null() and not isinstance(obj, _np.integer)):
         return tp
-    if _builtin_type(obj) is builtin_tuple:
+    if isinstance(obj, builtin_tuple):
+        if is_pytuple_record(obj):
+            # Records like (1, 'a') are tuple values, not dimensions
+            return pytuple_record_type_for(obj)
         obj = list(obj)
     if _builtin_type(obj) is list:
         return ndt_type_from_pylist(obj)
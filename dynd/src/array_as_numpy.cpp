@@ -73,14 +73,11 @@ static int dynd_to_numpy_id(dynd::type_id_t id)
 }
 
 static void make_numpy_dtype_for_copy(pyobject_ownref *out_numpy_dtype, intptr_t ndim, const ndt::type &dt,
-                                      const char *arrmeta)
-{
-  // DyND builtin types
-  if (dt.is_builtin()) {
-    out_numpy_dtype->reset((PyObject *)PyArray_DescrFromType(dynd_to_numpy_id(dt.get_id())));
-    return;
-  }
+                                      const char *arrmeta);
 
+static void build_numpy_dtype_for_copy(pyobject_ownref *out_numpy_dtype, intptr_t ndim, const ndt::type &dt,
+                                       const char *arrmeta)
+{
   switch (dt.get_id()) {
   case fixed_string_id: {
     const ndt::fixed_string_type *fsd = dt.extended<ndt::fixed_string_type>();
@@ -227,6 +224,29 @@ static void make_numpy_dtype_for_copy(pyobject_ownref *out_numpy_dtype, intptr_t
   throw dynd::type_error(ss.str());
 }
 
+static void make_numpy_dtype_for_copy(pyobject_ownref *out_numpy_dtype, intptr_t ndim, const ndt::type &dt,
+                                      const char *arrmeta)
+{
+  // DyND builtin types
+  if (dt.is_builtin()) {
+    out_numpy_dtype->reset((PyObject *)PyArray_DescrFromType(dynd_to_numpy_id(dt.get_id())));
+    return;
+  }
+
+  // Struct and string dtypes are built from several Python objects, so those conversions are cached
+  if (dt.get_id() != struct_id && dt.get_id() != string_id) {
+    build_numpy_dtype_for_copy(out_numpy_dtype, ndim, dt, arrmeta);
+    return;
+  }
+  PyArray_Descr *cached = numpy_type_cache_lookup(dt);
+  if (cached != NULL) {
+    out_numpy_dtype->reset((PyObject *)cached);
+    return;
+  }
+  build_numpy_dtype_for_copy(out_numpy_dtype, ndim, dt, arrmeta);
+  numpy_type_cache_store(dt, (PyArray_Descr *)out_numpy_dtype->get());
+}
+
 static void as_numpy_analysis(pyobject_ownref *out_numpy_dtype, bool *out_requires_copy, intptr_t ndim,
                               const ndt::type &dt, const char *arrmeta)
 {
@@ -5,9 +5,12 @@
 
 #include <Python.h>
 
+#include <vector>
+
 #include <dynd/shape_tools.hpp>
 #include <dynd/types/fixed_string_type.hpp>
 #include <dynd/types/struct_type.hpp>
+#include <dynd/types/var_dim_type.hpp>
 
 #include "array_as_pep3118.hpp"
 #include "array_functions.hpp"
@@ -238,6 +241,69 @@ static void array_getbuffer_pep3118_bytes(const ndt::type &tp, const char *arrme
   buffer->shape[0] = buffer->len;
 }
 
+/**
+ * Fills the shape, strides and suboffsets of an indirect PEP 3118 buffer for
+ * dimension ``i`` and the dimensions inside it. ``data`` points at the data of
+ * dimension ``i``, which for a var dimension holds the pointer to its row, so
+ * the enclosing dimension gets the suboffset which PEP 3118 adds after
+ * following that pointer. Every row of a var dimension must have the same
+ * size, because the buffer has a single shape.
+ */
+static void fill_indirect_buffer_dims(const ndt::type &tp, const char *arrmeta, const char *data, int i,
+                                      int last_var_dim, Py_buffer *buffer)
+{
+  intptr_t dim_size, stride;
+  const char *el_data;
+  const char *el_arrmeta;
+  if (tp.get_id() == var_dim_id) {
+    const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+    const ndt::var_dim_type::data_type *d = reinterpret_cast<const ndt::var_dim_type::data_type *>(data);
+    dim_size = d->size;
+    stride = md->stride;
+    el_data = d->begin + md->offset;
+    el_arrmeta = arrmeta + sizeof(ndt::var_dim_type::metadata_type);
+    if (i == 0) {
+      // An outermost var dimension has a single row, which the buffer starts at
+      buffer->buf = const_cast<char *>(el_data);
+    }
+    else {
+      buffer->suboffsets[i - 1] = md->offset;
+    }
+  }
+  else {
+    const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
+    dim_size = md->dim_size;
+    stride = md->stride;
+    el_data = data;
+    el_arrmeta = arrmeta + sizeof(fixed_dim_type_arrmeta);
+  }
+
+  if (buffer->shape[i] < 0) {
+    buffer->shape[i] = dim_size;
+    buffer->strides[i] = stride;
+  }
+  else if (buffer->shape[i] != dim_size) {
+    stringstream ss;
+    ss << "Cannot get an indirect PEP 3118 buffer of ragged dynd array, dimension " << i << " has rows of sizes "
+       << buffer->shape[i] << " and " << dim_size << ", use nd.packed_buffers instead";
+    throw runtime_error(ss.str());
+  }
+
+  if (i + 1 == buffer->ndim) {
+    return;
+  }
+  const ndt::type &el_tp = tp.extended<ndt::base_dim_type>()->get_element_type();
+  if (i >= last_var_dim) {
+    // The remaining dimensions are fixed, so their shape is the same in every
+    // row and doesn't depend on the data
+    fill_indirect_buffer_dims(el_tp, el_arrmeta, el_data, i + 1, last_var_dim, buffer);
+    return;
+  }
+  for (intptr_t j = 0; j < dim_size; ++j) {
+    fill_indirect_buffer_dims(el_tp, el_arrmeta, el_data + j * stride, i + 1, last_var_dim, buffer);
+  }
+}
+
 int pydynd::array_getbuffer_pep3118(PyObject *ndo, Py_buffer *buffer, int flags)
 {
   // debug_print_getbuffer_flags(cout, flags);
@@ -274,53 +340,74 @@ int pydynd::array_getbuffer_pep3118(PyObject *ndo, Py_buffer *buffer, int flags)
       throw dynd::type_error(ss.str());
     }
 
-    // Create the format, and allocate the dynamic memory but Py_buffer needs
+    // Find the var dimensions, which are exported through suboffsets
+    int last_var_dim = -1;
+    ndt::type dim_tp = tp;
+    for (int i = 0; i < buffer->ndim; ++i) {
+      if (dim_tp.get_id() == var_dim_id) {
+        last_var_dim = i;
+      }
+      else if (dim_tp.get_id() != fixed_dim_id) {
+        stringstream ss;
+        ss << "Cannot get a strided view of dynd type " << n.get_type() << " for PEP 3118 buffer";
+        throw runtime_error(ss.str());
+      }
+      dim_tp = dim_tp.extended<ndt::base_dim_type>()->get_element_type();
+    }
+    bool indirect = last_var_dim >= 0;
+    if (indirect && (flags & PyBUF_INDIRECT) != PyBUF_INDIRECT) {
+      stringstream ss;
+      ss << "dynd type " << n.get_type() << " has var dimensions, which require a PyBUF_INDIRECT "
+         << "PEP 3118 request";
+      throw runtime_error(ss.str());
+    }
+
+    // Create the format, and allocate the dynamic memory Py_buffer needs
     char *uniform_arrmeta = n.get()->metadata();
     ndt::type uniform_tp = tp.get_type_at_dimension(&uniform_arrmeta, buffer->ndim);
+    std::string format;
     if ((flags & PyBUF_FORMAT) || uniform_tp.get_data_size() == 0) {
       // If the array data type doesn't have a fixed size, make_pep3118 fills
       // buffer->itemsize as a side effect
-      std::string format = make_pep3118_format(buffer->itemsize, uniform_tp, uniform_arrmeta);
-      if (flags & PyBUF_FORMAT) {
-        buffer->internal = malloc(2 * buffer->ndim * sizeof(intptr_t) + format.size() + 1);
-        buffer->shape = reinterpret_cast<Py_ssize_t *>(buffer->internal);
-        buffer->strides = buffer->shape + buffer->ndim;
-        buffer->format = reinterpret_cast<char *>(buffer->strides + buffer->ndim);
-        memcpy(buffer->format, format.c_str(), format.size() + 1);
-      }
-      else {
-        buffer->format = NULL;
-        buffer->internal = malloc(2 * buffer->ndim * sizeof(intptr_t));
-        buffer->shape = reinterpret_cast<Py_ssize_t *>(buffer->internal);
-        buffer->strides = buffer->shape + buffer->ndim;
-      }
+      format = make_pep3118_format(buffer->itemsize, uniform_tp, uniform_arrmeta);
     }
     else {
-      buffer->format = NULL;
       buffer->itemsize = uniform_tp.get_data_size();
-      buffer->internal = malloc(2 * buffer->ndim * sizeof(intptr_t));
-      buffer->shape = reinterpret_cast<Py_ssize_t *>(buffer->internal);
-      buffer->strides = buffer->shape + buffer->ndim;
+    }
+    // The shape, strides, suboffsets and format share one allocation
+    size_t ndim_slots = (indirect ? 3 : 2) * buffer->ndim;
+    size_t format_size = (flags & PyBUF_FORMAT) ? format.size() + 1 : 0;
+    buffer->internal = malloc(ndim_slots * sizeof(intptr_t) + format_size);
+    buffer->shape = reinterpret_cast<Py_ssize_t *>(buffer->internal);
+    buffer->strides = buffer->shape + buffer->ndim;
+    if (flags & PyBUF_FORMAT) {
+      buffer->format = reinterpret_cast<char *>(buffer->shape + ndim_slots);
+      memcpy(buffer->format, format.c_str(), format_size);
     }
 
     // Fill in the shape and strides
-    const char *arrmeta = n.get()->metadata();
-    for (int i = 0; i < buffer->ndim; ++i) {
-      switch (tp.get_id()) {
-      case fixed_dim_id: {
-        const ndt::fixed_dim_type *tdt = tp.extended<ndt::fixed_dim_type>();
+    if (indirect) {
+      buffer->suboffsets = buffer->strides + buffer->ndim;
+      for (int i = 0; i < buffer->ndim; ++i) {
+        buffer->shape[i] = -1;
+        buffer->strides[i] = 0;
+        buffer->suboffsets[i] = -1;
+      }
+      fill_indirect_buffer_dims(tp, n.get()->metadata(), n.cdata(), 0, last_var_dim, buffer);
+      // Dimensions inside empty rows were never reached
+      for (int i = 0; i < buffer->ndim; ++i) {
+        if (buffer->shape[i] < 0) {
+          buffer->shape[i] = 0;
+        }
+      }
+    }
+    else {
+      const char *arrmeta = n.get()->metadata();
+      for (int i = 0; i < buffer->ndim; ++i) {
         const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
         buffer->shape[i] = md->dim_size;
         buffer->strides[i] = md->stride;
         arrmeta += sizeof(fixed_dim_type_arrmeta);
-        tp = tdt->get_element_type();
-        break;
-      }
-      default: {
-        stringstream ss;
-        ss << "Cannot get a strided view of dynd type " << n.get_type() << " for PEP 3118 buffer";
-        throw runtime_error(ss.str());
-      }
       }
     }
 
@@ -331,7 +418,13 @@ int pydynd::array_getbuffer_pep3118(PyObject *ndo, Py_buffer *buffer, int flags)
     }
 
     // Check that any contiguity requirements are satisfied
-    if ((flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS || (flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
+    if (indirect) {
+      if ((flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS || (flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS ||
+          (flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS) {
+        throw runtime_error("dynd array with var dimensions is not contiguous as requested for PEP 3118 buffer");
+      }
+    }
+    else if ((flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS || (flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
       if (!strides_are_c_contiguous(buffer->ndim, buffer->itemsize, buffer->shape, buffer->strides)) {
         throw runtime_error("dynd array is not C-contiguous as requested for PEP 3118 buffer");
       }
@@ -381,6 +474,121 @@ int pydynd::array_getbuffer_pep3118(PyObject *ndo, Py_buffer *buffer, int flags)
   }
 }
 
+namespace {
+
+struct ragged_row {
+  const char *begin;
+  intptr_t size;
+};
+
+/**
+ * Appends the rows of the var dimension inside the fixed dimensions of ``tp`` in C order.
+ */
+void collect_ragged_rows(const ndt::type &tp, const char *arrmeta, const char *data, vector<ragged_row> &out_rows)
+{
+  if (tp.get_id() == fixed_dim_id) {
+    const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(arrmeta);
+    const ndt::type &el_tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+    for (intptr_t j = 0; j < md->dim_size; ++j) {
+      collect_ragged_rows(el_tp, arrmeta + sizeof(fixed_dim_type_arrmeta), data + j * md->stride, out_rows);
+    }
+    return;
+  }
+
+  const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+  const ndt::var_dim_type::data_type *d = reinterpret_cast<const ndt::var_dim_type::data_type *>(data);
+  ragged_row row = {d->begin + md->offset, static_cast<intptr_t>(d->size)};
+  out_rows.push_back(row);
+}
+
+} // anonymous namespace
+
+void pydynd::array_as_packed_pep3118(const nd::array &a, nd::array &out_data, nd::array &out_offsets)
+{
+  // Validate that the type is [fixed dims *] var * T, with no dimensions in T besides fixed ones
+  const char *arrmeta = a.get()->metadata();
+  ndt::type var_tp = a.get_type();
+  while (var_tp.get_id() == fixed_dim_id) {
+    var_tp = var_tp.extended<ndt::fixed_dim_type>()->get_element_type();
+    arrmeta += sizeof(fixed_dim_type_arrmeta);
+  }
+  bool valid = var_tp.get_id() == var_dim_id;
+  ndt::type el_tp;
+  if (valid) {
+    el_tp = var_tp.extended<ndt::var_dim_type>()->get_element_type();
+    ndt::type tp = el_tp;
+    while (tp.get_id() == fixed_dim_id) {
+      tp = tp.extended<ndt::fixed_dim_type>()->get_element_type();
+    }
+    valid = tp.get_base_id() != dim_kind_id;
+  }
+  if (!valid) {
+    stringstream ss;
+    ss << "Cannot export dynd type " << a.get_type() << " as packed buffers, it must have a single var dimension "
+       << "inside any fixed dimensions";
+    throw dynd::type_error(ss.str());
+  }
+
+  const ndt::var_dim_type::metadata_type *md = reinterpret_cast<const ndt::var_dim_type::metadata_type *>(arrmeta);
+  const char *el_arrmeta = arrmeta + sizeof(ndt::var_dim_type::metadata_type);
+  intptr_t el_size = el_tp.get_data_size();
+
+  vector<ragged_row> rows;
+  collect_ragged_rows(a.get_type(), a.get()->metadata(), a.cdata(), rows);
+
+  // Fill the offsets, and check whether the rows already follow each other in memory
+  out_offsets = nd::empty(ndt::make_fixed_dim(rows.size() + 1, ndt::make_type<int64_t>()));
+  int64_t *offsets = reinterpret_cast<int64_t *>(out_offsets.data());
+  const char *begin = NULL, *end = NULL;
+  bool packed = md->stride == el_size;
+  offsets[0] = 0;
+  for (size_t r = 0; r < rows.size(); ++r) {
+    offsets[r + 1] = offsets[r] + rows[r].size;
+    if (rows[r].size == 0) {
+      continue;
+    }
+    if (begin == NULL) {
+      begin = rows[r].begin;
+    }
+    else if (rows[r].begin != end) {
+      packed = false;
+    }
+    end = rows[r].begin + rows[r].size * md->stride;
+  }
+  intptr_t total = static_cast<intptr_t>(offsets[rows.size()]);
+
+  if (packed) {
+    char *data_arrmeta = NULL;
+    out_data = nd::make_strided_array_from_data(el_tp, 1, &total, &el_size, a.get_flags(), const_cast<char *>(begin),
+                                                md->blockref, &data_arrmeta);
+    if (el_tp.get_arrmeta_size() > 0) {
+      el_tp.extended()->arrmeta_copy_construct(data_arrmeta, el_arrmeta, a);
+    }
+    return;
+  }
+
+  // The rows are apart, so copy them next to each other if their elements are plain bytes
+  if (el_tp.get_arrmeta_size() > 0 || (el_tp.get_flags() & (type_flag_blockref | type_flag_destructor)) != 0) {
+    stringstream ss;
+    ss << "Cannot export dynd type " << a.get_type() << " as packed buffers, its rows are not stored contiguously";
+    throw runtime_error(ss.str());
+  }
+  out_data = nd::empty(ndt::make_fixed_dim(total, el_tp));
+  char *dst = out_data.data();
+  for (const ragged_row &row : rows) {
+    if (md->stride == el_size) {
+      memcpy(dst, row.begin, row.size * el_size);
+      dst += row.size * el_size;
+    }
+    else {
+      for (intptr_t j = 0; j < row.size; ++j) {
+        memcpy(dst, row.begin + j * md->stride, el_size);
+        dst += el_size;
+      }
+    }
+  }
+}
+
 int pydynd::array_releasebuffer_pep3118(PyObject *ndo, Py_buffer *buffer)
 {
   try {
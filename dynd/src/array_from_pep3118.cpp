@@ -0,0 +1,530 @@
+//
+// Copyright (C) 2011-16 DyND Developers
+// BSD 2-Clause License, see LICENSE.txt
+//
+
+#include <Python.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <dynd/memblock/external_memory_block.hpp>
+#include <dynd/types/fixed_bytes_type.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
+#include <dynd/types/fixed_string_type.hpp>
+#include <dynd/types/struct_type.hpp>
+
+#include "array_from_pep3118.hpp"
+#include "utility_functions.hpp"
+
+using namespace std;
+using namespace dynd;
+
+namespace {
+
+/**
+ * An item of a parsed PEP 3118 format, with the layout which dynd keeps in
+ * the arrmeta rather than in the type.
+ */
+struct pep3118_item {
+  // The full type, and the type inside any subarray dimensions
+  ndt::type tp;
+  ndt::type el_tp;
+  // The subarray shape, e.g. (2, 3) for "(2,3)d"
+  vector<intptr_t> shape;
+  // The size of the whole item and of one subarray element, in bytes
+  intptr_t size;
+  intptr_t el_size;
+  // The alignment dynd requires of the item's data
+  size_t data_alignment;
+  // False if some field is at an offset dynd can't access in place
+  bool aligned;
+  // The size of the units to reverse when copying a scalar, or 0 if it is
+  // in native byte order, and false if some field is not in native byte order
+  size_t swap_size;
+  bool native;
+  // The fields and their offsets, if el_tp is a struct
+  vector<pep3118_item> fields;
+  vector<uintptr_t> offsets;
+};
+
+bool is_little_endian()
+{
+  const uint16_t one = 1;
+  return *reinterpret_cast<const char *>(&one) == 1;
+}
+
+class pep3118_format_parser {
+  const char *m_format;
+  const char *m_p;
+  // The last byte order, size and alignment character seen
+  char m_mode;
+
+  void error(const std::string &msg) const
+  {
+    stringstream ss;
+    ss << msg << " in PEP 3118 format \"" << m_format << "\" at position " << (m_p - m_format);
+    throw dynd::type_error(ss.str());
+  }
+
+  intptr_t parse_int()
+  {
+    intptr_t result = 0;
+    while (*m_p >= '0' && *m_p <= '9') {
+      result = result * 10 + (*m_p++ - '0');
+    }
+    return result;
+  }
+
+  vector<intptr_t> parse_shape()
+  {
+    vector<intptr_t> shape;
+    ++m_p;
+    for (;;) {
+      if (*m_p < '0' || *m_p > '9') {
+        error("expected a dimension size");
+      }
+      shape.push_back(parse_int());
+      if (*m_p == ')') {
+        ++m_p;
+        return shape;
+      }
+      if (*m_p != ',') {
+        error("expected ',' or ')'");
+      }
+      ++m_p;
+    }
+  }
+
+  bool native_byte_order() const
+  {
+    switch (m_mode) {
+    case '<':
+      return is_little_endian();
+    case '>':
+    case '!':
+      return !is_little_endian();
+    default:
+      return true;
+    }
+  }
+
+  /**
+   * The size of the units whose bytes are reversed to change the byte order
+   * of a scalar type, e.g. each half of a complex number.
+   */
+  static size_t byteswap_size(const ndt::type &tp)
+  {
+    switch (tp.get_id()) {
+    case complex_float32_id:
+    case complex_float64_id:
+      return tp.get_data_size() / 2;
+    case fixed_string_id:
+      return string_encoding_char_size_table[tp.extended<ndt::fixed_string_type>()->get_encoding()];
+    case fixed_bytes_id:
+      return 1;
+    default:
+      return tp.get_data_size();
+    }
+  }
+
+  static ndt::type int_type(size_t size, bool is_signed)
+  {
+    switch (size) {
+    case 4:
+      return is_signed ? ndt::make_type<int32_t>() : ndt::make_type<uint32_t>();
+    default:
+      return is_signed ? ndt::make_type<int64_t>() : ndt::make_type<uint64_t>();
+    }
+  }
+
+  /**
+   * Parses a single character code, where ``count`` is the repeat count for
+   * string codes, which is part of their size rather than a dimension.
+   */
+  ndt::type parse_scalar(intptr_t count)
+  {
+    // Only the native mode uses the platform's sizes
+    bool native_sizes = m_mode == '@';
+    char c = *m_p++;
+    switch (c) {
+    case '?':
+      return ndt::make_type<bool1>();
+    case 'b':
+      return ndt::make_type<int8_t>();
+    case 'B':
+      return ndt::make_type<uint8_t>();
+    case 'h':
+      return ndt::make_type<int16_t>();
+    case 'H':
+      return ndt::make_type<uint16_t>();
+    case 'i':
+      return ndt::make_type<int32_t>();
+    case 'I':
+      return ndt::make_type<uint32_t>();
+    case 'l':
+      return int_type(native_sizes ? sizeof(long) : 4, true);
+    case 'L':
+      return int_type(native_sizes ? sizeof(long) : 4, false);
+    case 'q':
+      return ndt::make_type<int64_t>();
+    case 'Q':
+      return ndt::make_type<uint64_t>();
+    case 'n':
+      if (native_sizes) {
+        return int_type(sizeof(Py_ssize_t), true);
+      }
+      break;
+    case 'N':
+      if (native_sizes) {
+        return int_type(sizeof(size_t), false);
+      }
+      break;
+    case 'e':
+      return ndt::make_type<float16>();
+    case 'f':
+      return ndt::make_type<float>();
+    case 'd':
+      return ndt::make_type<double>();
+    case 'Z':
+      c = *m_p++;
+      if (c == 'f') {
+        return ndt::make_type<dynd::complex<float>>();
+      }
+      else if (c == 'd') {
+        return ndt::make_type<dynd::complex<double>>();
+      }
+      break;
+    case 'c':
+      return ndt::make_type<ndt::fixed_bytes_type>(count, 1);
+    case 's':
+      return ndt::make_type<ndt::fixed_string_type>(count, string_encoding_ascii);
+    case 'u':
+      return ndt::make_type<ndt::fixed_string_type>(count, string_encoding_utf_16);
+    case 'w':
+      return ndt::make_type<ndt::fixed_string_type>(count, string_encoding_utf_32);
+    default:
+      break;
+    }
+
+    --m_p;
+    error(string("unsupported type code '") + c + "'");
+    return ndt::type();
+  }
+
+  /**
+   * Parses the items up to ``end``, which is '}' inside a struct and '\0' at
+   * the top level, laying them out one after another.
+   */
+  pep3118_item parse_struct(char end)
+  {
+    char outer_mode = m_mode;
+    vector<pep3118_item> fields;
+    vector<uintptr_t> offsets;
+    vector<string> names;
+    uintptr_t offset = 0;
+    bool has_names = false;
+
+    for (;;) {
+      while (*m_p == ' ' || *m_p == '\t' || *m_p == '\n') {
+        ++m_p;
+      }
+      char c = *m_p;
+      if (c == end) {
+        break;
+      }
+      if (c == '\0') {
+        error("expected '}'");
+      }
+      if (c == '@' || c == '=' || c == '<' || c == '>' || c == '!' || c == '^') {
+        m_mode = c;
+        ++m_p;
+        continue;
+      }
+
+      vector<intptr_t> shape;
+      if (c == '(') {
+        shape = parse_shape();
+      }
+      bool has_count = *m_p >= '0' && *m_p <= '9';
+      intptr_t count = has_count ? parse_int() : 1;
+
+      if (*m_p == 'x') {
+        // Padding bytes
+        ++m_p;
+        offset += count;
+        continue;
+      }
+
+      pep3118_item item;
+      if (*m_p == 'T') {
+        if (m_p[1] != '{') {
+          ++m_p;
+          error("expected '{'");
+        }
+        m_p += 2;
+        item = parse_struct('}');
+        ++m_p;
+      }
+      else {
+        bool is_string = *m_p == 'c' || *m_p == 's' || *m_p == 'u' || *m_p == 'w';
+        item.el_tp = parse_scalar(count);
+        item.el_size = item.el_tp.get_data_size();
+        item.data_alignment = item.el_tp.get_data_alignment();
+        item.aligned = true;
+        item.swap_size = native_byte_order() ? 0 : byteswap_size(item.el_tp);
+        item.native = item.swap_size <= 1;
+        if (is_string) {
+          count = 1;
+        }
+      }
+      // A repeat count on anything but a string is a dimension
+      if (count != 1) {
+        shape.push_back(count);
+      }
+      item.shape = shape;
+      item.tp = shape.empty() ? item.el_tp : ndt::make_type(shape.size(), shape.data(), item.el_tp);
+      item.size = item.el_size;
+      for (intptr_t dim_size : shape) {
+        item.size *= dim_size;
+      }
+      // Subarray elements must keep every field aligned as well
+      if (!shape.empty() && !offset_is_aligned(item.el_size, item.data_alignment)) {
+        item.aligned = false;
+      }
+
+      string name;
+      if (*m_p == ':') {
+        const char *begin = ++m_p;
+        while (*m_p != ':') {
+          if (*m_p == '\0') {
+            error("expected ':' after the field name");
+          }
+          ++m_p;
+        }
+        name.assign(begin, m_p++);
+        has_names = true;
+      }
+
+      // The native mode pads each item to its natural alignment, like the struct module
+      if (m_mode == '@') {
+        offset = inc_to_alignment(offset, item.data_alignment);
+      }
+      offsets.push_back(offset);
+      offset += item.size;
+      names.push_back(name);
+      fields.push_back(std::move(item));
+    }
+    m_mode = outer_mode;
+
+    // A single unnamed item at the top level is the element itself
+    if (end == '\0' && fields.size() == 1 && !has_names && offsets[0] == 0) {
+      return std::move(fields[0]);
+    }
+
+    pep3118_item result;
+    vector<ndt::type> field_types;
+    result.data_alignment = 1;
+    result.aligned = true;
+    result.swap_size = 0;
+    result.native = true;
+    for (size_t i = 0; i < fields.size(); ++i) {
+      if (names[i].empty()) {
+        names[i] = "f" + to_string(i);
+      }
+      field_types.push_back(fields[i].tp);
+      result.data_alignment = max(result.data_alignment, fields[i].data_alignment);
+      result.aligned = result.aligned && fields[i].aligned && offset_is_aligned(offsets[i], fields[i].data_alignment);
+      result.native = result.native && fields[i].native;
+    }
+    result.el_tp = ndt::make_type<ndt::struct_type>(names, field_types);
+    result.el_size = offset;
+    result.tp = result.el_tp;
+    result.size = offset;
+    result.fields = std::move(fields);
+    result.offsets = std::move(offsets);
+    return result;
+  }
+
+public:
+  pep3118_format_parser(const char *format) : m_format(format), m_p(format), m_mode('@') {}
+
+  pep3118_item parse() { return parse_struct('\0'); }
+};
+
+/**
+ * Fills the arrmeta for an item parsed from a PEP 3118 format, which holds
+ * its subarray strides and struct field offsets.
+ */
+void fill_arrmeta_from_pep3118_item(const pep3118_item &item, char *arrmeta)
+{
+  if (!item.shape.empty()) {
+    fixed_dim_type_arrmeta *md = reinterpret_cast<fixed_dim_type_arrmeta *>(arrmeta);
+    intptr_t stride = item.el_size;
+    for (intptr_t i = item.shape.size() - 1; i >= 0; --i) {
+      md[i].dim_size = item.shape[i];
+      md[i].stride = stride;
+      stride *= item.shape[i];
+    }
+    arrmeta += item.shape.size() * sizeof(fixed_dim_type_arrmeta);
+  }
+
+  if (item.el_tp.get_id() == struct_id) {
+    const uintptr_t *arrmeta_offsets = item.el_tp.extended<ndt::struct_type>()->get_arrmeta_offsets_raw();
+    uintptr_t *offsets = reinterpret_cast<uintptr_t *>(arrmeta);
+    for (size_t i = 0; i < item.fields.size(); ++i) {
+      offsets[i] = item.offsets[i];
+      fill_arrmeta_from_pep3118_item(item.fields[i], arrmeta + arrmeta_offsets[i]);
+    }
+  }
+}
+
+/**
+ * Copies one item parsed from a PEP 3118 format into dynd's layout of its
+ * type byte by byte, so the source may be unaligned or in either byte order.
+ *
+ * \param dim  The first subarray dimension of the item to copy.
+ */
+void copy_pep3118_item(const pep3118_item &item, size_t dim, const char *src, const char *dst_arrmeta, char *dst)
+{
+  if (dim < item.shape.size()) {
+    const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta);
+    intptr_t src_stride = item.el_size;
+    for (size_t i = dim + 1; i < item.shape.size(); ++i) {
+      src_stride *= item.shape[i];
+    }
+    for (intptr_t i = 0; i < item.shape[dim]; ++i) {
+      copy_pep3118_item(item, dim + 1, src + i * src_stride, dst_arrmeta + sizeof(fixed_dim_type_arrmeta),
+                        dst + i * md->stride);
+    }
+  }
+  else if (item.el_tp.get_id() == struct_id) {
+    const uintptr_t *arrmeta_offsets = item.el_tp.extended<ndt::struct_type>()->get_arrmeta_offsets_raw();
+    const uintptr_t *dst_offsets = reinterpret_cast<const uintptr_t *>(dst_arrmeta);
+    for (size_t i = 0; i < item.fields.size(); ++i) {
+      copy_pep3118_item(item.fields[i], 0, src + item.offsets[i], dst_arrmeta + arrmeta_offsets[i],
+                        dst + dst_offsets[i]);
+    }
+  }
+  else if (item.swap_size > 1) {
+    for (intptr_t i = 0; i < item.el_size; i += item.swap_size) {
+      for (size_t j = 0; j < item.swap_size; ++j) {
+        dst[i + j] = src[i + item.swap_size - 1 - j];
+      }
+    }
+  }
+  else {
+    memcpy(dst, src, item.el_size);
+  }
+}
+
+/**
+ * Copies the items of a strided PEP 3118 buffer into a dynd array of the
+ * same shape, see copy_pep3118_item.
+ */
+void copy_pep3118_buffer(const pep3118_item &item, int ndim, const intptr_t *shape, const intptr_t *strides,
+                         const char *src, const char *dst_arrmeta, char *dst)
+{
+  if (ndim == 0) {
+    copy_pep3118_item(item, 0, src, dst_arrmeta, dst);
+    return;
+  }
+
+  const fixed_dim_type_arrmeta *md = reinterpret_cast<const fixed_dim_type_arrmeta *>(dst_arrmeta);
+  for (intptr_t i = 0; i < shape[0]; ++i) {
+    copy_pep3118_buffer(item, ndim - 1, shape + 1, strides + 1, src + i * strides[0],
+                        dst_arrmeta + sizeof(fixed_dim_type_arrmeta), dst + i * md->stride);
+  }
+}
+
+void release_py_buffer(void *buffer)
+{
+  pydynd::PyGILState_RAII pgs;
+  PyBuffer_Release(reinterpret_cast<Py_buffer *>(buffer));
+  delete reinterpret_cast<Py_buffer *>(buffer);
+}
+
+} // anonymous namespace
+
+ndt::type pydynd::make_type_from_pep3118_format(const char *format, intptr_t &out_itemsize)
+{
+  pep3118_item item = pep3118_format_parser(format).parse();
+  if (!item.native) {
+    stringstream ss;
+    ss << "PEP 3118 format \"" << format << "\" is not in native byte order, which a dynd type can't describe";
+    throw dynd::type_error(ss.str());
+  }
+  out_itemsize = item.size;
+  return item.tp;
+}
+
+nd::array pydynd::array_from_pep3118(PyObject *obj, uint32_t access_flags, bool always_copy)
+{
+  if (!always_copy && (access_flags & nd::immutable_access_flag)) {
+    throw runtime_error("cannot view a PEP 3118 buffer as immutable");
+  }
+
+  bool writable = !always_copy && (access_flags & nd::write_access_flag);
+  unique_ptr<Py_buffer> buffer(new Py_buffer);
+  if (PyObject_GetBuffer(obj, buffer.get(), writable ? PyBUF_RECORDS : PyBUF_RECORDS_RO) < 0) {
+    throw exception();
+  }
+  // From here on the memory block releases the buffer
+  nd::memory_block memblock = nd::make_memory_block<nd::external_memory_block>(buffer.get(), &release_py_buffer);
+  Py_buffer *view = buffer.release();
+
+  // A buffer without a format is unsigned bytes
+  const char *format = view->format != NULL ? view->format : "B";
+  pep3118_item item = pep3118_format_parser(format).parse();
+  if (item.size > view->itemsize) {
+    stringstream ss;
+    ss << "PEP 3118 format \"" << format << "\" describes " << item.size << " bytes, but the buffer itemsize is "
+       << view->itemsize;
+    throw dynd::type_error(ss.str());
+  }
+
+  int ndim = view->ndim;
+  vector<intptr_t> shape(ndim), strides(ndim);
+  intptr_t stride = view->itemsize;
+  for (int i = ndim - 1; i >= 0; --i) {
+    shape[i] = view->shape != NULL ? view->shape[i] : view->len / view->itemsize;
+    strides[i] = view->strides != NULL ? view->strides[i] : stride;
+    stride *= shape[i];
+  }
+
+  // dynd accesses a view's data in place, so it has to be aligned and in native byte order
+  bool aligned = item.aligned && offset_is_aligned(reinterpret_cast<uintptr_t>(view->buf), item.data_alignment);
+  for (int i = 0; i < ndim; ++i) {
+    aligned = aligned && offset_is_aligned(static_cast<size_t>(strides[i]), item.data_alignment);
+  }
+  if (!aligned || !item.native) {
+    if (!always_copy) {
+      stringstream ss;
+      ss << "cannot view PEP 3118 buffer with format \"" << format << "\" because its data is "
+         << (aligned ? "not in native byte order" : "not aligned");
+      throw runtime_error(ss.str());
+    }
+
+    // Copy byte by byte instead
+    nd::array result = nd::empty(ndim == 0 ? item.tp : ndt::make_type(ndim, shape.data(), item.tp));
+    copy_pep3118_buffer(item, ndim, shape.data(), strides.data(), reinterpret_cast<const char *>(view->buf),
+                        result.get()->metadata(), result.data());
+    if (access_flags == 0 || (access_flags & nd::write_access_flag)) {
+      return result;
+    }
+    return result.eval_copy(access_flags);
+  }
+
+  char *arrmeta = NULL;
+  nd::array result = nd::make_strided_array_from_data(
+      item.tp, ndim, shape.data(), strides.data(), nd::read_access_flag | (view->readonly ? 0 : nd::write_access_flag),
+      reinterpret_cast<char *>(view->buf), nd::memory_block(std::move(memblock).get(), true), &arrmeta);
+  fill_arrmeta_from_pep3118_item(item, arrmeta);
+
+  if (always_copy) {
+    return result.eval_copy(access_flags);
+  }
+
+  return result;
+}
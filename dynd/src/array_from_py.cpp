@@ -5,6 +5,13 @@
 
 #include <Python.h>
 #include <datetime.h>
+#if PY_VERSION_HEX >= 0x03000000 && PY_VERSION_HEX < 0x030B0000
+#include <longintrepr.h>
+#endif
+
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
 
 #include <dynd/callable.hpp>
 #include <dynd/exceptions.hpp>
@@ -13,6 +20,8 @@
 #include <dynd/option.hpp>
 #include <dynd/type_promotion.hpp>
 #include <dynd/types/bytes_type.hpp>
+#include <dynd/types/categorical_type.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/option_type.hpp>
 #include <dynd/types/string_type.hpp>
 #include <dynd/types/struct_type.hpp>
@@ -21,6 +30,7 @@
 #include <dynd/types/var_dim_type.hpp>
 
 #include "array_conversions.hpp"
+#include "array_from_pep3118.hpp"
 #include "array_from_py.hpp"
 #include "array_functions.hpp"
 #include "numpy_interop.hpp"
@@ -41,8 +51,52 @@ void pydynd::init_array_from_py()
 
 typedef void (*convert_one_pyscalar_function_t)(const ndt::type &tp, const char *arrmeta, char *out, PyObject *obj);
 
+/**
+ * Reads an exact Python int whose value is stored in compact form
+ * (a single digit) directly, without going through the generic
+ * PyLong conversion and its error checks. Returns false for int
+ * subclasses and multi-digit values.
+ */
+inline bool pyint_as_compact(PyObject *obj, long long &out)
+{
+#if PY_VERSION_HEX >= 0x030C0000
+  if (Py_TYPE(obj) == &PyLong_Type && PyUnstable_Long_IsCompact(reinterpret_cast<PyLongObject *>(obj))) {
+    out = PyUnstable_Long_CompactValue(reinterpret_cast<PyLongObject *>(obj));
+    return true;
+  }
+  return false;
+#elif PY_VERSION_HEX >= 0x03000000
+  if (Py_TYPE(obj) == &PyLong_Type) {
+    switch (Py_SIZE(obj)) {
+    case 0:
+      out = 0;
+      return true;
+    case 1:
+      out = static_cast<long long>(reinterpret_cast<PyLongObject *>(obj)->ob_digit[0]);
+      return true;
+    case -1:
+      out = -static_cast<long long>(reinterpret_cast<PyLongObject *>(obj)->ob_digit[0]);
+      return true;
+    default:
+      return false;
+    }
+  }
+  return false;
+#else
+  if (Py_TYPE(obj) == &PyInt_Type) {
+    out = PyInt_AS_LONG(obj);
+    return true;
+  }
+  return false;
+#endif
+}
+
 inline void convert_one_pyscalar_bool(const ndt::type &tp, const char *arrmeta, char *out, PyObject *obj)
 {
+  if (obj == Py_True || obj == Py_False) {
+    *out = (obj == Py_True);
+    return;
+  }
   *out = (PyObject_IsTrue(obj) != 0);
 }
 
@@ -61,6 +115,11 @@ inline void convert_one_pyscalar_int32(const ndt::type &tp, const char *arrmeta,
 
 inline void convert_one_pyscalar_int64(const ndt::type &tp, const char *arrmeta, char *out, PyObject *obj)
 {
+  long long compact_value;
+  if (pyint_as_compact(obj, compact_value)) {
+    *reinterpret_cast<int64_t *>(out) = compact_value;
+    return;
+  }
   int64_t value = PyLong_AsLongLong(obj);
   if (value == -1 && PyErr_Occurred()) {
     throw std::exception();
@@ -68,6 +127,40 @@ inline void convert_one_pyscalar_int64(const ndt::type &tp, const char *arrmeta,
   *reinterpret_cast<int64_t *>(out) = value;
 }
 
+inline void convert_one_pyscalar_uint64(const ndt::type &tp, const char *arrmeta, char *out, PyObject *obj)
+{
+  long long compact_value;
+  if (pyint_as_compact(obj, compact_value) && compact_value >= 0) {
+    *reinterpret_cast<uint64_t *>(out) = static_cast<uint64_t>(compact_value);
+    return;
+  }
+#if PY_VERSION_HEX < 0x03000000
+  if (PyInt_Check(obj)) {
+    long value = PyInt_AS_LONG(obj);
+    if (value < 0) {
+      throw std::overflow_error("overflow assigning to dynd uint64");
+    }
+    *reinterpret_cast<uint64_t *>(out) = static_cast<uint64_t>(value);
+    return;
+  }
+#endif
+  unsigned PY_LONG_LONG value = PyLong_AsUnsignedLongLong(obj);
+  if (value == static_cast<unsigned PY_LONG_LONG>(-1) && PyErr_Occurred()) {
+    throw std::exception();
+  }
+  *reinterpret_cast<uint64_t *>(out) = value;
+}
+
+inline void convert_one_pyscalar_int128(const ndt::type &tp, const char *arrmeta, char *out, PyObject *obj)
+{
+  long long compact_value;
+  if (pyint_as_compact(obj, compact_value)) {
+    *reinterpret_cast<dynd::int128 *>(out) = dynd::int128(compact_value);
+    return;
+  }
+  *reinterpret_cast<dynd::int128 *>(out) = pyint_as_int128(obj);
+}
+
 inline void convert_one_pyscalar_float32(const ndt::type &tp, const char *arrmeta, char *out, PyObject *obj)
 {
   double value = PyFloat_AsDouble(obj);
@@ -79,6 +172,10 @@ inline void convert_one_pyscalar_float32(const ndt::type &tp, const char *arrmet
 
 inline void convert_one_pyscalar_float64(const ndt::type &tp, const char *arrmeta, char *out, PyObject *obj)
 {
+  if (Py_TYPE(obj) == &PyFloat_Type) {
+    *reinterpret_cast<double *>(out) = PyFloat_AS_DOUBLE(obj);
+    return;
+  }
   double value = PyFloat_AsDouble(obj);
   if (value == -1 && PyErr_Occurred()) {
     throw std::exception();
@@ -123,6 +220,10 @@ inline void convert_one_pyscalar_ustring(const ndt::type &tp, const char *arrmet
 {
   dynd::string *out_usp = reinterpret_cast<dynd::string *>(out);
   if (PyUnicode_Check(obj)) {
+#if PY_VERSION_HEX >= 0x03030000
+    Py_ssize_t len = 0;
+    const char *s = pyunicode_as_utf8(obj, len);
+#else
     // Get it as UTF8
     pyobject_ownref utf8(PyUnicode_AsUTF8String(obj));
     char *s = NULL;
@@ -130,6 +231,7 @@ inline void convert_one_pyscalar_ustring(const ndt::type &tp, const char *arrmet
     if (PyBytes_AsStringAndSize(utf8.get(), &s, &len) < 0) {
       throw exception();
     }
+#endif
     out_usp->assign(s, len);
 #if PY_VERSION_HEX < 0x03000000
   }
@@ -180,7 +282,8 @@ static void fill_array_from_pylist(const ndt::type &tp, const char *arrmeta, cha
     return;
   }
 
-  Py_ssize_t size = PyList_GET_SIZE(obj);
+  Py_ssize_t size = PySequence_Fast_GET_SIZE(obj);
+  PyObject **items = PySequence_Fast_ITEMS(obj);
   const char *element_arrmeta = arrmeta;
   ndt::type element_tp = tp.at_single(0, &element_arrmeta);
   if (shape[current_axis] >= 0) {
@@ -189,15 +292,13 @@ static void fill_array_from_pylist(const ndt::type &tp, const char *arrmeta, cha
     intptr_t stride = md->stride;
     if (element_tp.is_scalar()) {
       for (Py_ssize_t i = 0; i < size; ++i) {
-        PyObject *item = PyList_GET_ITEM(obj, i);
-        ConvertOneFn(element_tp, element_arrmeta, data, item);
+        ConvertOneFn(element_tp, element_arrmeta, data, items[i]);
         data += stride;
       }
     }
     else {
       for (Py_ssize_t i = 0; i < size; ++i) {
-        fill_array_from_pylist<ConvertOneFn>(element_tp, element_arrmeta, data, PyList_GET_ITEM(obj, i), shape,
-                                             current_axis + 1);
+        fill_array_from_pylist<ConvertOneFn>(element_tp, element_arrmeta, data, items[i], shape, current_axis + 1);
         data += stride;
       }
     }
@@ -215,14 +316,13 @@ static void fill_array_from_pylist(const ndt::type &tp, const char *arrmeta, cha
     char *element_data = out->begin;
     if (element_tp.is_scalar()) {
       for (Py_ssize_t i = 0; i < size; ++i) {
-        PyObject *item = PyList_GET_ITEM(obj, i);
-        ConvertOneFn(element_tp, element_arrmeta, element_data, item);
+        ConvertOneFn(element_tp, element_arrmeta, element_data, items[i]);
         element_data += stride;
       }
     }
     else {
       for (Py_ssize_t i = 0; i < size; ++i) {
-        fill_array_from_pylist<ConvertOneFn>(element_tp, element_arrmeta, element_data, PyList_GET_ITEM(obj, i), shape,
+        fill_array_from_pylist<ConvertOneFn>(element_tp, element_arrmeta, element_data, items[i], shape,
                                              current_axis + 1);
         element_data += stride;
       }
@@ -230,16 +330,730 @@ static void fill_array_from_pylist(const ndt::type &tp, const char *arrmeta, cha
   }
 }
 
+/**
+ * Bulk converters for runs of list items whose Python type exactly
+ * matches the speculated element type. Each converts items until the
+ * first one which doesn't match, returning how many it consumed, so the
+ * caller can hand that item to the general scalar conversion.
+ */
+static Py_ssize_t bulk_convert_float64(PyObject *const *items, Py_ssize_t count, double *out)
+{
+  Py_ssize_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    PyObject *a = items[i], *b = items[i + 1], *c = items[i + 2], *d = items[i + 3];
+    if (Py_TYPE(a) != &PyFloat_Type || Py_TYPE(b) != &PyFloat_Type || Py_TYPE(c) != &PyFloat_Type ||
+        Py_TYPE(d) != &PyFloat_Type) {
+      break;
+    }
+    out[i] = PyFloat_AS_DOUBLE(a);
+    out[i + 1] = PyFloat_AS_DOUBLE(b);
+    out[i + 2] = PyFloat_AS_DOUBLE(c);
+    out[i + 3] = PyFloat_AS_DOUBLE(d);
+  }
+  for (; i < count && Py_TYPE(items[i]) == &PyFloat_Type; ++i) {
+    out[i] = PyFloat_AS_DOUBLE(items[i]);
+  }
+  return i;
+}
+
+/**
+ * Reads an exact Python int for bulk conversion to ``T``. Compact values
+ * only go up to 30 bits, so for int64 exact ints that aren't compact also
+ * go through PyLong_AsLongLongAndOverflow, which clears any error.
+ */
+template <typename T>
+inline bool pyint_as_bulk(PyObject *obj, long long &out)
+{
+  return pyint_as_compact(obj, out);
+}
+
+template <>
+inline bool pyint_as_bulk<int64_t>(PyObject *obj, long long &out)
+{
+  if (pyint_as_compact(obj, out)) {
+    return true;
+  }
+  if (!PyLong_CheckExact(obj)) {
+    return false;
+  }
+  int overflow = 0;
+  out = PyLong_AsLongLongAndOverflow(obj, &overflow);
+  if (overflow != 0 || (out == -1 && PyErr_Occurred())) {
+    PyErr_Clear();
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+static Py_ssize_t bulk_convert_int(PyObject *const *items, Py_ssize_t count, T *out)
+{
+  Py_ssize_t i = 0;
+  long long a, b, c, d;
+  for (; i + 4 <= count; i += 4) {
+    if (!pyint_as_bulk<T>(items[i], a) || !pyint_as_bulk<T>(items[i + 1], b) || !pyint_as_bulk<T>(items[i + 2], c) ||
+        !pyint_as_bulk<T>(items[i + 3], d)) {
+      break;
+    }
+    if (a < std::numeric_limits<T>::min() || a > std::numeric_limits<T>::max() ||
+        b < std::numeric_limits<T>::min() || b > std::numeric_limits<T>::max() ||
+        c < std::numeric_limits<T>::min() || c > std::numeric_limits<T>::max() ||
+        d < std::numeric_limits<T>::min() || d > std::numeric_limits<T>::max()) {
+      break;
+    }
+    out[i] = static_cast<T>(a);
+    out[i + 1] = static_cast<T>(b);
+    out[i + 2] = static_cast<T>(c);
+    out[i + 3] = static_cast<T>(d);
+  }
+  for (; i < count; ++i) {
+    if (!pyint_as_bulk<T>(items[i], a) || a < std::numeric_limits<T>::min() || a > std::numeric_limits<T>::max()) {
+      break;
+    }
+    out[i] = static_cast<T>(a);
+  }
+  return i;
+}
+
+static Py_ssize_t bulk_convert_uint64(PyObject *const *items, Py_ssize_t count, uint64_t *out)
+{
+  Py_ssize_t i = 0;
+  long long a;
+  for (; i < count; ++i) {
+    if (pyint_as_compact(items[i], a)) {
+      if (a < 0) {
+        break;
+      }
+      out[i] = static_cast<uint64_t>(a);
+    }
+    else if (PyLong_CheckExact(items[i])) {
+      // Values beyond 30 bits aren't compact
+      unsigned PY_LONG_LONG value = PyLong_AsUnsignedLongLong(items[i]);
+      if (value == static_cast<unsigned PY_LONG_LONG>(-1) && PyErr_Occurred()) {
+        PyErr_Clear();
+        break;
+      }
+      out[i] = value;
+    }
+    else {
+      break;
+    }
+  }
+  return i;
+}
+
+static Py_ssize_t bulk_convert_int128(PyObject *const *items, Py_ssize_t count, dynd::int128 *out)
+{
+  Py_ssize_t i = 0;
+  long long a;
+  for (; i < count; ++i) {
+    if (pyint_as_compact(items[i], a)) {
+      out[i] = dynd::int128(a < 0 ? ~0ULL : 0ULL, static_cast<uint64_t>(a));
+    }
+    else if (PyLong_CheckExact(items[i])) {
+      // Values beyond 64 bits go through append_scalar
+      int overflow = 0;
+      PY_LONG_LONG value = PyLong_AsLongLongAndOverflow(items[i], &overflow);
+      if (overflow != 0 || (value == -1 && PyErr_Occurred())) {
+        PyErr_Clear();
+        break;
+      }
+      out[i] = dynd::int128(value < 0 ? ~0ULL : 0ULL, static_cast<uint64_t>(value));
+    }
+    else {
+      break;
+    }
+  }
+  return i;
+}
+
+static Py_ssize_t bulk_convert_bool(PyObject *const *items, Py_ssize_t count, char *out)
+{
+  Py_ssize_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    PyObject *a = items[i], *b = items[i + 1], *c = items[i + 2], *d = items[i + 3];
+    if ((a != Py_True && a != Py_False) || (b != Py_True && b != Py_False) || (c != Py_True && c != Py_False) ||
+        (d != Py_True && d != Py_False)) {
+      break;
+    }
+    out[i] = (a == Py_True);
+    out[i + 1] = (b == Py_True);
+    out[i + 2] = (c == Py_True);
+    out[i + 3] = (d == Py_True);
+  }
+  for (; i < count && (items[i] == Py_True || items[i] == Py_False); ++i) {
+    out[i] = (items[i] == Py_True);
+  }
+  return i;
+}
+
+static Py_ssize_t bulk_collect_str(PyObject *const *items, Py_ssize_t count, PyObject **out)
+{
+  Py_ssize_t i = 0;
+  for (; i < count && PyUnicode_CheckExact(items[i]); ++i) {
+    out[i] = items[i];
+  }
+  return i;
+}
+
+// The most distinct values a string list may have to be dictionary-encoded
+static const size_t categorical_encode_max_categories = 65536;
+
+namespace {
+
+/**
+ * Single-pass ingestion of nested Python lists and tuples of numeric
+ * scalars or strings.
+ *
+ * Instead of deducing the shape and type in one pass and filling in
+ * a second, this walks the list once, guessing the element type from
+ * the first scalar and appending into a growable buffer of that type.
+ * When a wider scalar shows up (bool -> int32 -> int64 -> float64 ->
+ * complex[float64]), the values already in the buffer are widened in
+ * place. Ints beyond 64 bits widen the ints to uint64, or to int128 if
+ * any are negative, the same as the general deduction. Lists of str keep
+ * borrowed pointers to the items, and are copied into dynd strings once
+ * the whole list has been seen. Anything this can't handle (ragged or
+ * empty dimensions, mixed strings and numbers, None, ints beyond 64 bits
+ * mixed with floats, non-builtin scalars) makes it bail out so the caller
+ * can use the general two-pass deduction.
+ */
+class pylist_ingester {
+  enum scalar_kind_t {
+    kind_none = -1,
+    kind_bool,
+    kind_int32,
+    kind_int64,
+    kind_uint64,
+    kind_int128,
+    kind_float64,
+    kind_complex,
+    kind_string
+  };
+
+  // The shape deduced so far, one entry per list level seen
+  vector<intptr_t> m_shape;
+  // The depth at which scalars live, or -1 before the first scalar
+  intptr_t m_ndim;
+  // The speculative element type of the buffer
+  scalar_kind_t m_kind;
+  size_t m_itemsize;
+  // The element buffer, grown geometrically, and its element count
+  vector<char> m_buffer;
+  size_t m_count;
+  // Whether to dictionary-encode string results as categorical
+  bool m_encode_strings;
+
+  static size_t itemsize_of(scalar_kind_t kind)
+  {
+    switch (kind) {
+    case kind_bool:
+      return sizeof(char);
+    case kind_int32:
+      return sizeof(int32_t);
+    case kind_int64:
+      return sizeof(int64_t);
+    case kind_uint64:
+      return sizeof(uint64_t);
+    case kind_int128:
+      return sizeof(dynd::int128);
+    case kind_float64:
+      return sizeof(double);
+    case kind_complex:
+      return sizeof(dynd::complex<double>);
+    case kind_string:
+      return sizeof(PyObject *);
+    default:
+      return 0;
+    }
+  }
+
+  template <typename SrcType, typename DstType>
+  static void widen_in_place(char *data, size_t count)
+  {
+    // Walk backwards so the wider values never overwrite narrower ones still to be read
+    const SrcType *src = reinterpret_cast<const SrcType *>(data);
+    DstType *dst = reinterpret_cast<DstType *>(data);
+    for (size_t i = count; i-- > 0;) {
+      dst[i] = static_cast<DstType>(src[i]);
+    }
+  }
+
+  template <typename SrcType>
+  static void widen_to_int128_in_place(char *data, size_t count)
+  {
+    const SrcType *src = reinterpret_cast<const SrcType *>(data);
+    dynd::int128 *dst = reinterpret_cast<dynd::int128 *>(data);
+    for (size_t i = count; i-- > 0;) {
+      bool negative = std::is_signed<SrcType>::value && static_cast<int64_t>(src[i]) < 0;
+      dst[i] = dynd::int128(negative ? ~0ULL : 0ULL, static_cast<uint64_t>(src[i]));
+    }
+  }
+
+  template <typename T>
+  static bool any_negative(const char *data, size_t count)
+  {
+    const T *values = reinterpret_cast<const T *>(data);
+    for (size_t i = 0; i < count; ++i) {
+      if (values[i] < 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void promote(scalar_kind_t kind)
+  {
+    // Negative ints don't fit in uint64, so they widen to int128 instead
+    if (kind == kind_uint64 && ((m_kind == kind_int32 && any_negative<int32_t>(m_buffer.data(), m_count)) ||
+                                (m_kind == kind_int64 && any_negative<int64_t>(m_buffer.data(), m_count)))) {
+      kind = kind_int128;
+    }
+    size_t itemsize = itemsize_of(kind);
+    if (m_buffer.size() < m_count * itemsize) {
+      m_buffer.resize(m_count * itemsize);
+    }
+    // Step up one kind at a time, promotions are rare so this keeps it simple
+    while (m_kind < kind) {
+      char *data = m_buffer.data();
+      switch (m_kind) {
+      case kind_none:
+        break;
+      case kind_bool:
+        widen_in_place<char, int32_t>(data, m_count);
+        break;
+      case kind_int32:
+        widen_in_place<int32_t, int64_t>(data, m_count);
+        break;
+      case kind_int64:
+        if (kind == kind_int128) {
+          widen_to_int128_in_place<int64_t>(data, m_count);
+          m_kind = kind_int128;
+          continue;
+        }
+        else if (kind == kind_uint64) {
+          widen_in_place<int64_t, uint64_t>(data, m_count);
+        }
+        else {
+          widen_in_place<int64_t, double>(data, m_count);
+          m_kind = kind_float64;
+          continue;
+        }
+        break;
+      case kind_uint64:
+        widen_to_int128_in_place<uint64_t>(data, m_count);
+        break;
+      case kind_float64:
+        widen_in_place<double, dynd::complex<double>>(data, m_count);
+        break;
+      default:
+        break;
+      }
+      m_kind = static_cast<scalar_kind_t>(m_kind + 1);
+    }
+    m_itemsize = itemsize;
+  }
+
+  void reserve(size_t count)
+  {
+    if (m_buffer.size() < count * m_itemsize) {
+      m_buffer.resize(max(count * m_itemsize, 2 * m_buffer.size()));
+    }
+  }
+
+  /**
+   * Appends the leading run of items which exactly match the
+   * speculated element type, returning how many were consumed.
+   */
+  Py_ssize_t append_bulk(PyObject *const *items, Py_ssize_t count)
+  {
+    reserve(m_count + count);
+    char *out = m_buffer.data() + m_count * m_itemsize;
+    Py_ssize_t consumed;
+    switch (m_kind) {
+    case kind_bool:
+      consumed = bulk_convert_bool(items, count, out);
+      break;
+    case kind_int32:
+      consumed = bulk_convert_int<int32_t>(items, count, reinterpret_cast<int32_t *>(out));
+      break;
+    case kind_int64:
+      consumed = bulk_convert_int<int64_t>(items, count, reinterpret_cast<int64_t *>(out));
+      break;
+    case kind_uint64:
+      consumed = bulk_convert_uint64(items, count, reinterpret_cast<uint64_t *>(out));
+      break;
+    case kind_int128:
+      consumed = bulk_convert_int128(items, count, reinterpret_cast<dynd::int128 *>(out));
+      break;
+    case kind_float64:
+      consumed = bulk_convert_float64(items, count, reinterpret_cast<double *>(out));
+      break;
+    case kind_string:
+      consumed = bulk_collect_str(items, count, reinterpret_cast<PyObject **>(out));
+      break;
+    default:
+      consumed = 0;
+      break;
+    }
+    m_count += consumed;
+    return consumed;
+  }
+
+  bool append_scalar(PyObject *obj)
+  {
+#if PY_VERSION_HEX >= 0x03030000
+    if (PyUnicode_Check(obj)) {
+      if (m_kind == kind_none) {
+        m_kind = kind_string;
+        m_itemsize = sizeof(PyObject *);
+      }
+      else if (m_kind != kind_string) {
+        return false;
+      }
+      reserve(m_count + 1);
+      reinterpret_cast<PyObject **>(m_buffer.data())[m_count++] = obj;
+      return true;
+    }
+#endif
+    if (m_kind == kind_string) {
+      return false;
+    }
+
+    scalar_kind_t kind;
+    long long ivalue = 0;
+    uint64_t uvalue = 0;
+    dynd::int128 i128value;
+    double re = 0, im = 0;
+    if (PyBool_Check(obj)) {
+      kind = kind_bool;
+      ivalue = (obj == Py_True);
+#if PY_VERSION_HEX < 0x03000000
+    }
+    else if (PyInt_Check(obj)) {
+      ivalue = PyInt_AS_LONG(obj);
+      kind = (ivalue >= INT_MIN && ivalue <= INT_MAX) ? kind_int32 : kind_int64;
+#endif
+    }
+    else if (PyLong_Check(obj)) {
+      int overflow = 0;
+      ivalue = PyLong_AsLongLongAndOverflow(obj, &overflow);
+      if (overflow > 0) {
+        uvalue = PyLong_AsUnsignedLongLong(obj);
+        if (uvalue == static_cast<uint64_t>(-1) && PyErr_Occurred()) {
+          PyErr_Clear();
+          overflow = -1;
+        }
+        else {
+          kind = kind_uint64;
+        }
+      }
+      if (overflow < 0) {
+        convert_one_pyscalar_int128(ndt::type(), NULL, reinterpret_cast<char *>(&i128value), obj);
+        kind = kind_int128;
+      }
+      else if (overflow == 0) {
+        if (ivalue == -1 && PyErr_Occurred()) {
+          throw std::exception();
+        }
+        kind = (ivalue >= INT_MIN && ivalue <= INT_MAX) ? kind_int32 : kind_int64;
+      }
+    }
+    else if (PyFloat_Check(obj)) {
+      kind = kind_float64;
+      re = PyFloat_AS_DOUBLE(obj);
+    }
+    else if (PyComplex_Check(obj)) {
+      kind = kind_complex;
+      re = PyComplex_RealAsDouble(obj);
+      im = PyComplex_ImagAsDouble(obj);
+    }
+    else {
+      return false;
+    }
+
+    // Ints beyond 64 bits and floats don't mix here, and a negative int makes uint64 values int128
+    bool big_int = kind == kind_uint64 || kind == kind_int128 || m_kind == kind_uint64 || m_kind == kind_int128;
+    if (big_int && (kind >= kind_float64 || m_kind >= kind_float64)) {
+      return false;
+    }
+    if (m_kind == kind_uint64 && kind < kind_uint64 && ivalue < 0) {
+      kind = kind_int128;
+    }
+    if (kind > m_kind) {
+      promote(kind);
+    }
+    reserve(m_count + 1);
+
+    char *out = m_buffer.data() + m_count * m_itemsize;
+    switch (m_kind) {
+    case kind_bool:
+      *out = (ivalue != 0);
+      break;
+    case kind_int32:
+      *reinterpret_cast<int32_t *>(out) = static_cast<int32_t>(ivalue);
+      break;
+    case kind_int64:
+      *reinterpret_cast<int64_t *>(out) = ivalue;
+      break;
+    case kind_uint64:
+      *reinterpret_cast<uint64_t *>(out) = (kind == kind_uint64) ? uvalue : static_cast<uint64_t>(ivalue);
+      break;
+    case kind_int128:
+      if (kind == kind_int128) {
+        *reinterpret_cast<dynd::int128 *>(out) = i128value;
+      }
+      else if (kind == kind_uint64) {
+        *reinterpret_cast<dynd::int128 *>(out) = dynd::int128(0ULL, uvalue);
+      }
+      else {
+        *reinterpret_cast<dynd::int128 *>(out) = dynd::int128(ivalue < 0 ? ~0ULL : 0ULL, static_cast<uint64_t>(ivalue));
+      }
+      break;
+    case kind_float64:
+      *reinterpret_cast<double *>(out) = (kind == kind_float64) ? re : static_cast<double>(ivalue);
+      break;
+    case kind_complex:
+      *reinterpret_cast<dynd::complex<double> *>(out) =
+          (kind == kind_complex || kind == kind_float64) ? dynd::complex<double>(re, im)
+                                                         : dynd::complex<double>(static_cast<double>(ivalue), 0.0);
+      break;
+    default:
+      return false;
+    }
+    ++m_count;
+    return true;
+  }
+
+  bool visit(PyObject *obj, size_t current_axis)
+  {
+    // Namedtuples are records, so they bail out as non-builtin scalars. Other
+    // tuples only get through as dimensions when their items don't mix kinds.
+    if (PyList_Check(obj) || PyTuple_CheckExact(obj)) {
+      Py_ssize_t size = PySequence_Fast_GET_SIZE(obj);
+      if (m_shape.size() == current_axis) {
+        if (m_ndim >= 0 || size == 0) {
+          // Mixed scalars and lists, or an empty list whose
+          // element type can't be guessed
+          return false;
+        }
+        m_shape.push_back(size);
+      }
+      else if (m_shape[current_axis] != size) {
+        // A variable-sized dimension
+        return false;
+      }
+
+      PyObject *const *items = PySequence_Fast_ITEMS(obj);
+      for (Py_ssize_t i = 0; i < size; ++i) {
+        if (m_ndim == static_cast<intptr_t>(current_axis + 1)) {
+          // The items are scalars, take the exact-type fast path
+          // as far as it goes
+          i += append_bulk(items + i, size - i);
+          if (i == size) {
+            break;
+          }
+        }
+        if (!visit(items[i], current_axis + 1)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    if (m_ndim < 0) {
+      if (m_shape.size() != current_axis) {
+        return false;
+      }
+      m_ndim = current_axis;
+    }
+    else if (m_ndim != static_cast<intptr_t>(current_axis)) {
+      return false;
+    }
+    return append_scalar(obj);
+  }
+
+#if PY_VERSION_HEX >= 0x03030000
+  nd::array make_string_array()
+  {
+    PyObject *const *items = reinterpret_cast<PyObject *const *>(m_buffer.data());
+    // Size all the UTF-8 payloads first, so encoding errors surface
+    // before the result is allocated
+    vector<pair<const char *, Py_ssize_t>> payloads(m_count);
+    for (size_t i = 0; i < m_count; ++i) {
+      payloads[i].first = pyunicode_as_utf8(items[i], payloads[i].second);
+    }
+
+    nd::array result = pydynd::make_strided_array(ndt::make_type<ndt::string_type>(), m_ndim, m_shape.data());
+    dynd::string *out = reinterpret_cast<dynd::string *>(result.data());
+    for (size_t i = 0; i < m_count; ++i) {
+      out[i].assign(payloads[i].first, payloads[i].second);
+    }
+    return result;
+  }
+#endif
+
+  struct pystr_hash {
+    // CPython caches the hash on str objects, so this is cheap after the first call
+    size_t operator()(PyObject *obj) const { return static_cast<size_t>(PyObject_Hash(obj)); }
+  };
+
+  struct pystr_equal {
+    bool operator()(PyObject *lhs, PyObject *rhs) const { return lhs == rhs || PyUnicode_Compare(lhs, rhs) == 0; }
+  };
+
+  template <typename StorageType>
+  static void write_categorical_codes(char *out, const vector<uint32_t> &codes, const vector<uint32_t> &storage_values)
+  {
+    StorageType *out_typed = reinterpret_cast<StorageType *>(out);
+    for (size_t i = 0; i < codes.size(); ++i) {
+      out_typed[i] = static_cast<StorageType>(storage_values[codes[i]]);
+    }
+  }
+
+  nd::array make_categorical_array()
+  {
+    // Intern the strings, numbering the distinct values in order of first appearance
+    PyObject *const *items = reinterpret_cast<PyObject *const *>(m_buffer.data());
+    unordered_map<PyObject *, uint32_t, pystr_hash, pystr_equal> interned;
+    vector<PyObject *> categories;
+    vector<uint32_t> codes(m_count);
+    size_t max_categories = min(categorical_encode_max_categories, m_count / 2);
+    for (size_t i = 0; i < m_count; ++i) {
+      auto it = interned.find(items[i]);
+      if (it == interned.end()) {
+        if (categories.size() == max_categories) {
+          // Too many distinct values for the encoding to pay off
+          return make_string_array();
+        }
+        it = interned.insert(make_pair(items[i], static_cast<uint32_t>(categories.size()))).first;
+        categories.push_back(items[i]);
+      }
+      codes[i] = it->second;
+    }
+
+    intptr_t category_count = categories.size();
+    nd::array category_values =
+        pydynd::make_strided_array(ndt::make_type<ndt::string_type>(), 1, &category_count);
+    dynd::string *category_data = reinterpret_cast<dynd::string *>(category_values.data());
+    for (intptr_t i = 0; i < category_count; ++i) {
+      Py_ssize_t len = 0;
+      const char *s = pyunicode_as_utf8(categories[i], len);
+      category_data[i].assign(s, len);
+    }
+
+    // Let the categorical type say how each category is stored, rather
+    // than assuming the storage order matches first appearance
+    ndt::type tp = ndt::make_type<ndt::categorical_type>(category_values);
+    const ndt::categorical_type *cat_tp = tp.extended<ndt::categorical_type>();
+    vector<uint32_t> storage_values(category_count);
+    for (intptr_t i = 0; i < category_count; ++i) {
+      storage_values[i] = cat_tp->get_value_from_category(category_values(i));
+    }
+
+    nd::array result = pydynd::make_strided_array(tp, m_ndim, m_shape.data());
+    switch (tp.get_data_size()) {
+    case 1:
+      write_categorical_codes<uint8_t>(result.data(), codes, storage_values);
+      break;
+    case 2:
+      write_categorical_codes<uint16_t>(result.data(), codes, storage_values);
+      break;
+    default:
+      write_categorical_codes<uint32_t>(result.data(), codes, storage_values);
+      break;
+    }
+    return result;
+  }
+
+public:
+  pylist_ingester(bool encode_strings = false)
+      : m_ndim(-1), m_kind(kind_none), m_itemsize(0), m_count(0), m_encode_strings(encode_strings)
+  {
+  }
+
+  /**
+   * Ingests the list or tuple, returning a NULL nd::array if it
+   * needs the general deduction path instead.
+   */
+  nd::array operator()(PyObject *obj)
+  {
+    if (!visit(obj, 0) || m_ndim <= 0) {
+      return nd::array();
+    }
+
+#if PY_VERSION_HEX >= 0x03030000
+    if (m_kind == kind_string) {
+      return m_encode_strings ? make_categorical_array() : make_string_array();
+    }
+#endif
+
+    ndt::type tp;
+    switch (m_kind) {
+    case kind_bool:
+      tp = ndt::make_type<bool>();
+      break;
+    case kind_int32:
+      tp = ndt::make_type<int32_t>();
+      break;
+    case kind_int64:
+      tp = ndt::make_type<int64_t>();
+      break;
+    case kind_uint64:
+      tp = ndt::make_type<uint64_t>();
+      break;
+    case kind_int128:
+      tp = ndt::make_type<dynd::int128>();
+      break;
+    case kind_float64:
+      tp = ndt::make_type<double>();
+      break;
+    case kind_complex:
+      tp = ndt::make_type<dynd::complex<double>>();
+      break;
+    default:
+      return nd::array();
+    }
+
+    // The buffer is already in C order, matching the default strides
+    nd::array result = pydynd::make_strided_array(tp, m_ndim, m_shape.data());
+    memcpy(result.data(), m_buffer.data(), m_count * m_itemsize);
+    return result;
+  }
+};
+
+} // anonymous namespace
+
+dynd::nd::array pydynd::array_from_pyseq_speculative(PyObject *obj, bool encode_strings)
+{
+  if (PyList_Check(obj) || PyTuple_Check(obj)) {
+    return pylist_ingester(encode_strings)(obj);
+  }
+
+  // Other sequences, like range, are materialized once so the
+  // ingestion can use direct item access
+  pyobject_ownref seq(PySequence_Fast(obj, "expected a sequence"));
+  return pylist_ingester(encode_strings)(seq.get());
+}
+
 static dynd::nd::array array_from_pylist(PyObject *obj)
 {
   // TODO: Add ability to specify access flags (e.g. immutable)
+  // Most lists are uniformly shaped numeric data, which the speculative
+  // single-pass ingestion handles without a separate deduction pass
+  nd::array spec_result = array_from_pyseq_speculative(obj);
+  if (spec_result.get() != NULL) {
+    return spec_result;
+  }
+
   // Do a pass through all the data to deduce its type and shape
   vector<intptr_t> shape;
   ndt::type tp = ndt::make_type<void>();
-  Py_ssize_t size = PyList_GET_SIZE(obj);
+  Py_ssize_t size = PySequence_Fast_GET_SIZE(obj);
   shape.push_back(size);
+  bool negative_int_seen = false;
   for (Py_ssize_t i = 0; i < size; ++i) {
-    deduce_pylist_shape_and_dtype(PyList_GET_ITEM(obj, i), shape, tp, 1);
+    deduce_pylist_shape_and_dtype(PySequence_Fast_GET_ITEM(obj, i), shape, tp, 1, negative_int_seen);
   }
   // If no type was deduced, return with no result. This will fall
   // through to the array_from_py_dynamic code.
@@ -264,6 +1078,14 @@ static dynd::nd::array array_from_pylist(PyObject *obj)
     fill_array_from_pylist<convert_one_pyscalar_int64>(result.get_type(), result.get()->metadata(), result.data(), obj,
                                                        &shape[0], 0);
     break;
+  case uint64_id:
+    fill_array_from_pylist<convert_one_pyscalar_uint64>(result.get_type(), result.get()->metadata(), result.data(),
+                                                        obj, &shape[0], 0);
+    break;
+  case int128_id:
+    fill_array_from_pylist<convert_one_pyscalar_int128>(result.get_type(), result.get()->metadata(), result.data(),
+                                                        obj, &shape[0], 0);
+    break;
   case float32_id:
     fill_array_from_pylist<convert_one_pyscalar_float32>(result.get_type(), result.get()->metadata(), result.data(),
                                                          obj, &shape[0], 0);
@@ -303,6 +1125,10 @@ static dynd::nd::array array_from_pylist(PyObject *obj)
                                                         &shape[0], 0);
     break;
   }
+  case tuple_id:
+    // Records, like the tuples of [(1, 'a'), (2, 'b')], are assigned field by field
+    result.assign(pyobject_array(obj));
+    break;
   default: {
     stringstream ss;
     ss << "Deduced type from Python list, " << tp << ", doesn't have a dynd array conversion function yet";
@@ -313,6 +1139,242 @@ static dynd::nd::array array_from_pylist(PyObject *obj)
   return result;
 }
 
+// The first chunk pulled from an iterator, later chunks double up to the maximum
+static const intptr_t pyiter_initial_chunk_size = 64;
+static const intptr_t pyiter_max_chunk_size = 65536;
+
+/**
+ * Pulls up to max_size items from the iterator into a new
+ * list, which owns the references to them.
+ */
+static PyObject *pyiter_next_chunk(PyObject *it, intptr_t max_size)
+{
+  pyobject_ownref chunk(PyList_New(0));
+  for (intptr_t i = 0; i < max_size; ++i) {
+    PyObject *item = PyIter_Next(it);
+    if (item == NULL) {
+      if (PyErr_Occurred()) {
+        throw std::exception();
+      }
+      break;
+    }
+    int res = PyList_Append(chunk.get(), item);
+    Py_DECREF(item);
+    if (res < 0) {
+      throw std::exception();
+    }
+  }
+  return chunk.release();
+}
+
+/**
+ * Assigns a list of Python objects into contiguous elements
+ * of type ``dtp`` starting at ``dst``.
+ */
+static void assign_pyobject_chunk(const ndt::type &dtp, char *dst, PyObject *chunk)
+{
+  intptr_t size = PyList_GET_SIZE(chunk);
+  nd::array dst_view = nd::make_array(ndt::make_fixed_dim(size, dtp), dst, nd::write_access_flag);
+  fixed_dim_type_arrmeta *md = reinterpret_cast<fixed_dim_type_arrmeta *>(dst_view.get()->metadata());
+  md->dim_size = size;
+  md->stride = dtp.get_data_size();
+  if (!dtp.is_builtin()) {
+    dtp.extended()->arrmeta_default_construct(reinterpret_cast<char *>(md + 1), true);
+  }
+  dst_view.assign(pyobject_array(chunk));
+}
+
+dynd::nd::array pydynd::array_from_pyiter(PyObject *obj, const ndt::type &dtp, intptr_t count)
+{
+  if (dtp.get_ndim() != 0) {
+    stringstream ss;
+    ss << "streaming ingestion requires a scalar dtype, got " << dtp;
+    throw dynd::type_error(ss.str());
+  }
+  pyobject_ownref it(PyObject_GetIter(obj));
+  intptr_t data_size = dtp.get_data_size();
+  intptr_t chunk_size = pyiter_initial_chunk_size;
+
+  if (count >= 0) {
+    // The size is known up front, so fill the result directly
+    nd::array result = pydynd::make_strided_array(dtp, 1, &count);
+    intptr_t size = 0;
+    while (size < count) {
+      pyobject_ownref chunk(pyiter_next_chunk(it.get(), min(chunk_size, count - size)));
+      intptr_t n = PyList_GET_SIZE(chunk.get());
+      if (n == 0) {
+        stringstream ss;
+        ss << "iterator provided only " << size << " of the " << count << " requested elements";
+        throw std::runtime_error(ss.str());
+      }
+      assign_pyobject_chunk(dtp, result.data() + size * data_size, chunk.get());
+      size += n;
+      chunk_size = min(2 * chunk_size, pyiter_max_chunk_size);
+    }
+    return result;
+  }
+
+  nd::array result = nd::empty(ndt::make_type<ndt::var_dim_type>(dtp));
+  if (dtp.get_flags() & type_flag_destructor) {
+    // Element types which own memory can't be moved around by
+    // resizing the element buffer, so materialize the iterator
+    pyobject_ownref seq(PySequence_List(it.get()));
+    result.assign(pyobject_array(seq.get()));
+    return result;
+  }
+
+  // Append chunks into a geometrically growing element buffer
+  // allocated from the var_dim's pod memory block
+  const ndt::var_dim_type::metadata_type *md =
+      reinterpret_cast<const ndt::var_dim_type::metadata_type *>(result.get()->metadata());
+  ndt::var_dim_type::data_type *out = reinterpret_cast<ndt::var_dim_type::data_type *>(result.data());
+  intptr_t capacity = chunk_size;
+  out->begin = md->blockref->alloc(capacity);
+  out->size = 0;
+  for (;;) {
+    pyobject_ownref chunk(pyiter_next_chunk(it.get(), chunk_size));
+    intptr_t n = PyList_GET_SIZE(chunk.get());
+    if (n == 0) {
+      break;
+    }
+    if (static_cast<intptr_t>(out->size) + n > capacity) {
+      capacity = max(2 * capacity, static_cast<intptr_t>(out->size) + n);
+      out->begin = md->blockref->resize(out->begin, capacity);
+    }
+    assign_pyobject_chunk(dtp, out->begin + out->size * data_size, chunk.get());
+    out->size += n;
+    chunk_size = min(2 * chunk_size, pyiter_max_chunk_size);
+  }
+  // Seal the result, giving back the unused capacity
+  if (static_cast<intptr_t>(out->size) < capacity) {
+    out->begin = md->blockref->resize(out->begin, out->size);
+  }
+  return result;
+}
+
+namespace {
+
+// The units of array_from_pydatetimes, as numpy names them, in microseconds. Nanoseconds are a
+// multiple of a microsecond, which is marked by zero.
+struct datetime_unit {
+  const char *name;
+  int64_t us;
+};
+
+const datetime_unit datetime_units[] = {{"W", 7 * 86400000000LL}, {"D", 86400000000LL}, {"h", 3600000000LL},
+                                        {"m", 60000000LL},        {"s", 1000000LL},     {"ms", 1000LL},
+                                        {"us", 1LL},              {"ns", 0LL}};
+
+// The tick numpy uses for NaT
+const int64_t datetime_nat = numeric_limits<int64_t>::min();
+
+/**
+ * Returns the number of days from 1970-01-01 to the given date of the
+ * proleptic Gregorian calendar.
+ */
+int64_t days_from_civil(int64_t year, int64_t month, int64_t day)
+{
+  year -= month <= 2;
+  int64_t era = (year >= 0 ? year : year - 399) / 400;
+  int64_t year_of_era = year - era * 400;
+  int64_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * 146097 + day_of_era - 719468;
+}
+
+/**
+ * Reads a datetime.datetime or datetime.date as microseconds since
+ * 1970-01-01, or a datetime.timedelta as microseconds, setting
+ * ``is_delta`` to which of the two it is.
+ */
+int64_t pydatetime_as_us(PyObject *obj, bool &is_delta)
+{
+  if (PyDelta_Check(obj)) {
+    is_delta = true;
+    PyDateTime_Delta *delta = reinterpret_cast<PyDateTime_Delta *>(obj);
+    return (static_cast<int64_t>(delta->days) * 86400 + delta->seconds) * 1000000 + delta->microseconds;
+  }
+
+  // A datetime.datetime is also a datetime.date
+  if (PyDate_Check(obj)) {
+    is_delta = false;
+    int64_t days = days_from_civil(PyDateTime_GET_YEAR(obj), PyDateTime_GET_MONTH(obj), PyDateTime_GET_DAY(obj));
+    int64_t us = days * 86400000000LL;
+    if (PyDateTime_Check(obj)) {
+      if (reinterpret_cast<PyDateTime_DateTime *>(obj)->hastzinfo) {
+        stringstream ss;
+        ss << "cannot convert the timezone-aware datetime " << pyobject_repr(obj) << " to ticks";
+        throw invalid_argument(ss.str());
+      }
+      us += ((PyDateTime_DATE_GET_HOUR(obj) * 60LL + PyDateTime_DATE_GET_MINUTE(obj)) * 60 +
+             PyDateTime_DATE_GET_SECOND(obj)) *
+                1000000 +
+            PyDateTime_DATE_GET_MICROSECOND(obj);
+    }
+    return us;
+  }
+
+  stringstream ss;
+  ss << "cannot convert " << pyobject_repr(obj) << " to datetime ticks";
+  throw invalid_argument(ss.str());
+}
+
+} // anonymous namespace
+
+dynd::nd::array pydynd::array_from_pydatetimes(PyObject *obj, const std::string &unit)
+{
+  const datetime_unit *u = NULL;
+  for (const datetime_unit &candidate : datetime_units) {
+    if (unit == candidate.name) {
+      u = &candidate;
+      break;
+    }
+  }
+  if (u == NULL) {
+    stringstream ss;
+    ss << "unsupported datetime unit \"" << unit << "\"";
+    throw invalid_argument(ss.str());
+  }
+
+  pyobject_ownref seq(PySequence_Fast(obj, "expected a sequence of datetime values"));
+  intptr_t size = PySequence_Fast_GET_SIZE(seq.get());
+  PyObject **items = PySequence_Fast_ITEMS(seq.get());
+  nd::array result = pydynd::make_strided_array(ndt::make_type<int64_t>(), 1, &size);
+  int64_t *out = reinterpret_cast<int64_t *>(result.data());
+  int kind = -1;
+  for (intptr_t i = 0; i < size; ++i) {
+    if (items[i] == Py_None) {
+      out[i] = datetime_nat;
+      continue;
+    }
+
+    bool is_delta = false;
+    int64_t us = pydatetime_as_us(items[i], is_delta);
+    if (kind < 0) {
+      kind = is_delta;
+    }
+    else if (kind != static_cast<int>(is_delta)) {
+      throw invalid_argument("cannot mix datetime and timedelta values in datetime ticks");
+    }
+
+    if (u->us != 0) {
+      // Like numpy, round towards the earlier tick
+      int64_t ticks = us / u->us;
+      out[i] = (us % u->us < 0) ? ticks - 1 : ticks;
+    }
+    else if (us > numeric_limits<int64_t>::max() / 1000 || us < datetime_nat / 1000) {
+      stringstream ss;
+      ss << pyobject_repr(items[i]) << " is out of range for nanosecond ticks";
+      throw overflow_error(ss.str());
+    }
+    else {
+      out[i] = us * 1000;
+    }
+  }
+
+  return result;
+}
+
 dynd::nd::array pydynd::array_from_py(PyObject *obj, uint32_t access_flags, bool always_copy)
 {
   // If it's a Cython w_array
@@ -366,17 +1428,23 @@ dynd::nd::array pydynd::array_from_py(PyObject *obj, uint32_t access_flags, bool
 #endif // PY_VERSION_HEX < 0x03000000
   }
   else if (PyLong_Check(obj)) {
-    PY_LONG_LONG value = PyLong_AsLongLong(obj);
-    if (value == -1 && PyErr_Occurred()) {
-      throw runtime_error("error converting int value");
-    }
-
-    // Use a 32-bit int if it fits.
-    if (value >= INT_MIN && value <= INT_MAX) {
-      result = nd::array(static_cast<int>(value));
-    }
-    else {
-      result = nd::array(value);
+    // Ints beyond 64 bits promote through uint64 to int128
+    bool negative = false;
+    ndt::type tp = pyint_type_for(obj, negative);
+    result = nd::empty(tp);
+    switch (tp.get_id()) {
+    case int32_id:
+      convert_one_pyscalar_int32(tp, NULL, result.data(), obj);
+      break;
+    case int64_id:
+      convert_one_pyscalar_int64(tp, NULL, result.data(), obj);
+      break;
+    case uint64_id:
+      convert_one_pyscalar_uint64(tp, NULL, result.data(), obj);
+      break;
+    default:
+      convert_one_pyscalar_int128(tp, NULL, result.data(), obj);
+      break;
     }
   }
   else if (PyFloat_Check(obj)) {
@@ -451,10 +1519,18 @@ dynd::nd::array pydynd::array_from_py(PyObject *obj, uint32_t access_flags, bool
     result = nd::empty(ndt::make_type<ndt::string_type>());
     reinterpret_cast<dynd::string *>(result.data())->assign(s, len);
   }
+  else if (PyObject_CheckBuffer(obj)) {
+    // Any other PEP 3118 exporter, e.g. bytearray, memoryview or array.array
+    return array_from_pep3118(obj, access_flags, always_copy);
+  }
   else if (PyObject_TypeCheck(obj, get_type_pytypeobject())) {
     result = nd::array(type_to_cpp_ref(obj));
   }
-  else if (PyList_Check(obj)) {
+  else if (PyTuple_Check(obj) && is_pytuple_record(obj)) {
+    result = nd::empty(pytuple_record_type_for(obj));
+    result.assign(pyobject_array(obj));
+  }
+  else if (PyList_Check(obj) || PyTuple_Check(obj)) {
     result = array_from_pylist(obj);
   }
   else if (PyType_Check(obj)) {
@@ -465,6 +1541,11 @@ dynd::nd::array pydynd::array_from_py(PyObject *obj, uint32_t access_flags, bool
     result = nd::array(dynd_ndt_cpp_type_for(obj));
 #endif // DYND_NUMPY_INTEROP
   }
+  else if (PySequence_Check(obj)) {
+    // Any other sequence, e.g. range, goes through the list path
+    pyobject_ownref seq(PySequence_Fast(obj, "expected a sequence"));
+    result = array_from_pylist(seq.get());
+  }
 
   if (result.get() == NULL) {
     pyobject_ownref pytpstr(PyObject_Str((PyObject *)Py_TYPE(obj)));
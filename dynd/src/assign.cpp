@@ -6,10 +6,20 @@
 #include <Python.h>
 #include <datetime.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
 #include <dynd/functional.hpp>
+#include <dynd/kernels/kernel_builder.hpp>
 #include <dynd/kernels/tuple_assignment_kernels.hpp>
 #include <dynd/type.hpp>
 
+#include "array_functions.hpp"
 #include "assign.hpp"
 #include "callables/assign_from_pyobject_callable.hpp"
 #include "callables/assign_to_pyarrayobject_callable.hpp"
@@ -93,37 +103,320 @@ PYDYND_API void assign_init()
   for (const auto &pair : nd::callable::make_all<pydynd::nd::assign_to_pyobject_callable, types>()) {
     nd::assign.overload(ndt::make_type<pyobject_type>(), {type_for_id(pair.first[0])}, pair.second);
   }
+  // Categorical values export as their categories, e.g. the strings of nd.array(lst, encode='auto')
+  nd::assign.overload(ndt::make_type<pyobject_type>(), {ndt::make_type<ndt::categorical_kind_type>()},
+                      nd::make_callable<pydynd::nd::assign_to_pyobject_callable<ndt::categorical_type>>());
+  // Objects are copied by reference, e.g. into a pyobject array from a NumPy object array
+  nd::assign.overload(ndt::make_type<pyobject_type>(), {ndt::make_type<pyobject_type>()},
+                      nd::make_callable<pydynd::nd::assign_from_pyobject_callable<pyobject_type>>());
+}
+
+PyObject *array_as_py(const dynd::nd::array &a, const std::string &records)
+{
+  struct_export_mode_t mode;
+  if (records == "dict") {
+    mode = struct_export_dict;
+  }
+  else if (records == "tuple") {
+    mode = struct_export_tuple;
+  }
+  else if (records == "namedtuple") {
+    mode = struct_export_namedtuple;
+  }
+  else {
+    stringstream ss;
+    ss << "Invalid records mode \"" << records << "\", expected \"dict\", \"tuple\" or \"namedtuple\"";
+    throw invalid_argument(ss.str());
+  }
+
+  // The kernel is built here rather than through res.assign(a), so the mode reaches the struct export
+  // callables as the resolve data of this call only
+  nd::array res = pydynd::pyobject_array(NULL);
+  ndt::type dst_tp = res.get_type();
+  ndt::type src_tp = a.get_type();
+  nd::call_graph cg;
+  nd::assign->resolve(nullptr, reinterpret_cast<char *>(&mode), cg, dst_tp, 1, &src_tp, 0, nullptr,
+                      std::map<std::string, ndt::type>());
+  nd::kernel_builder kb(cg.get());
+  const char *src_arrmeta = a.get()->metadata();
+  kb(kernel_request_single, nullptr, res.get()->metadata(), 1, &src_arrmeta);
+  nd::kernel_prefix *ck = kb.get();
+  char *src_data = const_cast<char *>(a.cdata());
+  ck->get_function<kernel_single_t>()(ck, res.data(), &src_data);
+
+  // The pyobject type doesn't own its value, so the reference made by the kernel passes to the caller
+  return *reinterpret_cast<PyObject **>(res.data());
+}
+
+// How large copies into numpy arrays are split across threads, see set_numpy_copy_threading
+static intptr_t numpy_copy_grain_size = 1 << 20;
+static intptr_t numpy_copy_threshold = 16 << 20;
+static intptr_t numpy_copy_max_threads = 0;
+
+void set_numpy_copy_threading(intptr_t grain_size, intptr_t threshold, intptr_t max_threads)
+{
+  if (grain_size <= 0 || threshold < 0 || max_threads < 0) {
+    throw invalid_argument("numpy copy threading needs a positive grain size and a non-negative threshold and "
+                           "thread count");
+  }
+  numpy_copy_grain_size = grain_size;
+  numpy_copy_threshold = threshold;
+  numpy_copy_max_threads = max_threads;
+}
+
+void get_numpy_copy_threading(intptr_t &out_grain_size, intptr_t &out_threshold, intptr_t &out_max_threads)
+{
+  out_grain_size = numpy_copy_grain_size;
+  out_threshold = numpy_copy_threshold;
+  out_max_threads = numpy_copy_max_threads;
 }
 
 #if DYND_NUMPY_INTEROP
 
 nd::callable assign_to_pyarrayobject = nd::functional::elwise(nd::make_callable<assign_to_pyarrayobject_callable>());
 
+/**
+ * Returns true if values of the type are or contain Python objects, so
+ * assigning them needs the GIL.
+ */
+static bool type_holds_pyobjects(const ndt::type &tp)
+{
+  ndt::type dtp = tp.get_dtype();
+  if (dtp.get_id() == ndt::id_of<pyobject_type>::value) {
+    return true;
+  }
+  if (dtp.get_id() == struct_id || dtp.get_id() == tuple_id) {
+    for (const ndt::type &field_tp : dtp.extended<ndt::tuple_type>()->get_field_types()) {
+      if (type_holds_pyobjects(field_tp)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * Returns the dynd type which views elements of numpy dtype ``dtype``.
+ */
+static ndt::type numpy_element_type(PyArray_Descr *dtype, uintptr_t dst_alignment)
+{
+  if (PyDataType_ISOBJECT(dtype)) {
+    return ndt::make_type<pyobject_type>();
+  }
+  return pydynd::_type_from_numpy_dtype(dtype, dst_alignment);
+}
+
+static void assign_to_numpy_view(intptr_t ndim, const intptr_t *shape, const intptr_t *strides,
+                                 const ndt::type &dst_el_tp, const char *dst_el_arrmeta, char *dst_data,
+                                 const ndt::type &src_tp, const char *src_arrmeta, const char *src_data);
+
+/**
+ * Assigns a dynd array into numpy data of the given shape, strides and
+ * dtype, through a dynd view of the numpy data. Numpy structs holding
+ * objects have no dynd view type, so they are assigned field by field.
+ */
+static void assign_to_numpy_data(intptr_t ndim, const intptr_t *shape, const intptr_t *strides, PyArray_Descr *dtype,
+                                 char *dst_data, uintptr_t dst_alignment, const ndt::type &src_tp,
+                                 const char *src_arrmeta, const char *src_data)
+{
+  if (PyDataType_HASFIELDS(dtype) && PyDataType_FLAGCHK(dtype, NPY_ITEM_HASOBJECT)) {
+    // Walk the source's fixed dimensions alongside the numpy ones down to the struct
+    ndt::type src_el_tp = src_tp;
+    const char *src_el_arrmeta = src_arrmeta;
+    vector<intptr_t> src_strides(ndim);
+    for (intptr_t i = 0; i < ndim; ++i) {
+      const fixed_dim_type_arrmeta *am = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_el_arrmeta);
+      if (src_el_tp.get_id() != fixed_dim_id || am->dim_size != shape[i]) {
+        stringstream ss;
+        ss << "Cannot assign from source dynd type " << src_tp << " to numpy type "
+           << pydynd::pyobject_repr((PyObject *)dtype);
+        throw invalid_argument(ss.str());
+      }
+      src_strides[i] = am->stride;
+      src_el_tp = src_el_tp.extended<ndt::fixed_dim_type>()->get_element_type();
+      src_el_arrmeta += sizeof(fixed_dim_type_arrmeta);
+    }
+
+    vector<PyArray_Descr *> field_dtypes;
+    vector<std::string> field_names;
+    vector<size_t> field_offsets;
+    pydynd::extract_fields_from_numpy_struct(dtype, field_dtypes, field_names, field_offsets);
+    if ((src_el_tp.get_id() != struct_id && src_el_tp.get_id() != tuple_id) ||
+        static_cast<intptr_t>(field_dtypes.size()) != src_el_tp.extended<ndt::tuple_type>()->get_field_count()) {
+      stringstream ss;
+      ss << "Cannot assign from source dynd type " << src_tp << " to numpy type "
+         << pydynd::pyobject_repr((PyObject *)dtype);
+      throw invalid_argument(ss.str());
+    }
+
+    // Assign each dynd field, with the source dimensions rebuilt on top of it, into the numpy field with its name
+    const ndt::tuple_type *tt = src_el_tp.extended<ndt::tuple_type>();
+    const uintptr_t *src_data_offsets = reinterpret_cast<const uintptr_t *>(src_el_arrmeta);
+    const uintptr_t *src_arrmeta_offsets = tt->get_arrmeta_offsets_raw();
+    for (size_t dst_i = 0; dst_i < field_dtypes.size(); ++dst_i) {
+      intptr_t src_i = dst_i;
+      if (src_el_tp.get_id() == struct_id) {
+        src_i = src_el_tp.extended<ndt::struct_type>()->get_field_index(field_names[dst_i]);
+        if (src_i < 0) {
+          stringstream ss;
+          ss << "Cannot assign from source dynd type " << src_tp << " to numpy type "
+             << pydynd::pyobject_repr((PyObject *)dtype);
+          throw invalid_argument(ss.str());
+        }
+      }
+      const ndt::type &field_tp = tt->get_field_type(src_i);
+      vector<char> field_arrmeta(ndim * sizeof(fixed_dim_type_arrmeta) + field_tp.get_arrmeta_size());
+      fixed_dim_type_arrmeta *field_am = reinterpret_cast<fixed_dim_type_arrmeta *>(field_arrmeta.data());
+      for (intptr_t i = 0; i < ndim; ++i) {
+        field_am[i].dim_size = shape[i];
+        field_am[i].stride = src_strides[i];
+      }
+      if (field_tp.get_arrmeta_size() > 0) {
+        memcpy(field_am + ndim, src_el_arrmeta + src_arrmeta_offsets[src_i], field_tp.get_arrmeta_size());
+      }
+      assign_to_numpy_data(ndim, shape, strides, field_dtypes[dst_i], dst_data + field_offsets[dst_i],
+                           dst_alignment | field_offsets[dst_i], ndt::make_type(ndim, shape, field_tp),
+                           field_arrmeta.data(), src_data + src_data_offsets[src_i]);
+    }
+    return;
+  }
+
+  ndt::type dst_el_tp = numpy_element_type(dtype, dst_alignment);
+  vector<char> dst_el_arrmeta(dst_el_tp.get_arrmeta_size());
+  if (!dst_el_tp.is_builtin()) {
+    pydynd::fill_arrmeta_from_numpy_dtype(dst_el_tp, dtype, dst_el_arrmeta.data());
+  }
+  assign_to_numpy_view(ndim, shape, strides, dst_el_tp, dst_el_arrmeta.data(), dst_data, src_tp, src_arrmeta,
+                       src_data);
+}
+
+/**
+ * Assigns a dynd array into numpy data of the given shape and strides,
+ * whose elements are viewed as ``dst_el_tp`` with arrmeta ``dst_el_arrmeta``.
+ * This doesn't use the Python API when neither side holds Python objects.
+ */
+static void assign_to_numpy_view(intptr_t ndim, const intptr_t *shape, const intptr_t *strides,
+                                 const ndt::type &dst_el_tp, const char *dst_el_arrmeta, char *dst_data,
+                                 const ndt::type &src_tp, const char *src_arrmeta, const char *src_data)
+{
+  vector<char> dst_arrmeta(ndim * sizeof(fixed_dim_type_arrmeta) + dst_el_tp.get_arrmeta_size());
+  fixed_dim_type_arrmeta *dst_am = reinterpret_cast<fixed_dim_type_arrmeta *>(dst_arrmeta.data());
+  for (intptr_t i = 0; i < ndim; ++i) {
+    dst_am[i].dim_size = shape[i];
+    dst_am[i].stride = shape[i] != 1 ? strides[i] : 0;
+  }
+  if (dst_el_tp.get_arrmeta_size() > 0) {
+    memcpy(dst_am + ndim, dst_el_arrmeta, dst_el_tp.get_arrmeta_size());
+  }
+  ndt::type dst_tp = ndt::make_type(ndim, shape, dst_el_tp);
+
+  nd::array kwd = nd::empty(ndt::make_type<ndt::option_type>(ndt::make_type<int>()));
+  *reinterpret_cast<int *>(kwd.data()) = static_cast<int>(assign_error_fractional);
+  char *src_data_nonconst = const_cast<char *>(src_data);
+  nd::assign->call(dst_tp, dst_arrmeta.data(), dst_data, 1, &src_tp, &src_arrmeta, &src_data_nonconst, 1, &kwd,
+                   std::map<std::string, ndt::type>());
+}
+
 void array_copy_to_numpy(PyArrayObject *dst_arr, const dynd::ndt::type &src_tp, const char *src_arrmeta,
                          const char *src_data)
 {
   intptr_t dst_ndim = PyArray_NDIM(dst_arr);
-  intptr_t src_ndim = src_tp.get_ndim();
-  uintptr_t dst_alignment = reinterpret_cast<uintptr_t>(PyArray_DATA(dst_arr));
-
-  strided_of_numpy_arrmeta dst_am_holder;
-  const char *dst_am = reinterpret_cast<const char *>(&dst_am_holder.sdt[NPY_MAXDIMS - dst_ndim]);
-  // Fill in metadata for a multi-dim strided array, corresponding
-  // to the numpy array, with a void type at the end for the numpy
-  // specific data.
+  const intptr_t *shape = PyArray_SHAPE(dst_arr);
+  const intptr_t *strides = PyArray_STRIDES(dst_arr);
+  PyArray_Descr *dtype = PyArray_DESCR(dst_arr);
+  char *dst_data = PyArray_BYTES(dst_arr);
+  uintptr_t dst_alignment = reinterpret_cast<uintptr_t>(dst_data);
   for (intptr_t i = 0; i < dst_ndim; ++i) {
-    dynd::fixed_dim_type_arrmeta &am = dst_am_holder.sdt[NPY_MAXDIMS - dst_ndim + i];
-    am.stride = PyArray_STRIDE(dst_arr, (int)i);
-    dst_alignment |= static_cast<uintptr_t>(am.stride);
-    am.dim_size = PyArray_DIM(dst_arr, (int)i);
+    dst_alignment |= static_cast<uintptr_t>(strides[i]);
   }
-  dynd::ndt::type dst_tp = dynd::ndt::make_type(dst_ndim, PyArray_SHAPE(dst_arr), dynd::ndt::make_type<void>());
-  dst_am_holder.am.dst_dtype = PyArray_DTYPE(dst_arr);
-  dst_am_holder.am.dst_alignment = dst_alignment;
 
-  char *src_data_nonconst = const_cast<char *>(src_data);
-  assign_to_pyarrayobject->call(dst_tp, dst_am, (char *)PyArray_DATA(dst_arr), 1, &src_tp, &src_arrmeta,
-                                &src_data_nonconst, 1, NULL, std::map<std::string, dynd::ndt::type>());
+  // Copies without Python objects on either side are split along the outer dimension, and run on a pool of
+  // threads with the GIL released. Small copies stay on this thread.
+  intptr_t nbytes = PyArray_NBYTES(dst_arr);
+  intptr_t nthreads = numpy_copy_max_threads > 0 ? numpy_copy_max_threads
+                                                 : static_cast<intptr_t>(std::thread::hardware_concurrency());
+  if (dst_ndim == 0 || nbytes < numpy_copy_threshold || nthreads <= 1 || src_tp.get_id() != fixed_dim_id ||
+      reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta)->dim_size != shape[0] ||
+      PyDataType_FLAGCHK(dtype, NPY_ITEM_HASOBJECT) || type_holds_pyobjects(src_tp)) {
+    assign_to_numpy_data(dst_ndim, shape, strides, dtype, dst_data, dst_alignment, src_tp, src_arrmeta, src_data);
+    return;
+  }
+
+  intptr_t row_bytes = std::max<intptr_t>(nbytes / shape[0], 1);
+  intptr_t rows_per_task = std::max<intptr_t>(numpy_copy_grain_size / row_bytes, 1);
+  intptr_t ntasks = (shape[0] + rows_per_task - 1) / rows_per_task;
+  nthreads = std::min(nthreads, ntasks);
+
+  // Everything which uses the Python API or libdynd's dispatch happens here, while the GIL is held. A strided
+  // kernel over the outer dimension is instantiated once, and the workers only call it on their rows.
+  ndt::type dst_el_tp = numpy_element_type(dtype, dst_alignment);
+  vector<char> dst_arrmeta(dst_ndim * sizeof(fixed_dim_type_arrmeta) + dst_el_tp.get_arrmeta_size());
+  fixed_dim_type_arrmeta *dst_am = reinterpret_cast<fixed_dim_type_arrmeta *>(dst_arrmeta.data());
+  for (intptr_t i = 0; i < dst_ndim; ++i) {
+    dst_am[i].dim_size = shape[i];
+    dst_am[i].stride = shape[i] != 1 ? strides[i] : 0;
+  }
+  if (!dst_el_tp.is_builtin()) {
+    pydynd::fill_arrmeta_from_numpy_dtype(dst_el_tp, dtype, reinterpret_cast<char *>(dst_am + dst_ndim));
+  }
+  ndt::type dst_row_tp = ndt::make_type(dst_ndim - 1, shape + 1, dst_el_tp);
+  const char *dst_row_arrmeta = reinterpret_cast<const char *>(dst_am + 1);
+  const ndt::type &src_row_tp = src_tp.extended<ndt::fixed_dim_type>()->get_element_type();
+  const char *src_row_arrmeta = src_arrmeta + sizeof(fixed_dim_type_arrmeta);
+  intptr_t dst_stride = strides[0];
+  intptr_t src_stride = reinterpret_cast<const fixed_dim_type_arrmeta *>(src_arrmeta)->stride;
+
+  nd::array kwd = nd::empty(ndt::make_type<ndt::option_type>(ndt::make_type<int>()));
+  *reinterpret_cast<int *>(kwd.data()) = static_cast<int>(assign_error_fractional);
+  nd::call_graph cg;
+  nd::assign->resolve(nullptr, nullptr, cg, dst_row_tp, 1, &src_row_tp, 1, &kwd, std::map<std::string, ndt::type>());
+  nd::kernel_builder kb(cg.get());
+  kb(kernel_request_strided, nullptr, dst_row_arrmeta, 1, &src_row_arrmeta);
+  nd::kernel_prefix *ck = kb.get();
+  kernel_strided_t ck_fn = ck->get_function<kernel_strided_t>();
+
+  std::atomic<intptr_t> next_task(0);
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  auto work = [&]() {
+    for (intptr_t task = next_task++; task < ntasks; task = next_task++) {
+      intptr_t begin = task * rows_per_task;
+      intptr_t end = std::min(begin + rows_per_task, shape[0]);
+      char *task_src_data = const_cast<char *>(src_data) + begin * src_stride;
+      try {
+        // Assignment kernels between types without Python objects keep no state between calls, so one
+        // kernel can run on several threads at once
+        ck_fn(ck, dst_data + begin * dst_stride, dst_stride, &task_src_data, &src_stride, end - begin);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        next_task = ntasks;
+      }
+    }
+  };
+
+  PyThreadState *thread_state = PyEval_SaveThread();
+  vector<std::thread> workers;
+  try {
+    for (intptr_t i = 1; i < nthreads; ++i) {
+      workers.emplace_back(work);
+    }
+  }
+  catch (const std::system_error &) {
+    // Run with the threads that could be started
+  }
+  work();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  PyEval_RestoreThread(thread_state);
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
 }
 
 #endif // DYND_NUMPY_INTEROP
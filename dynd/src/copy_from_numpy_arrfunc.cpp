@@ -6,17 +6,19 @@
 #include <Python.h>
 #include <datetime.h>
 
+#include <algorithm>
+#include <cstring>
+
 #include "array_functions.hpp"
 #include "copy_from_numpy_arrfunc.hpp"
 #include "numpy_interop.hpp"
 #include "utility_functions.hpp"
 
-#include <dynd/functional.hpp>
-#include <dynd/kernels/assignment_kernels.hpp>
-#include <dynd/kernels/tuple_assignment_kernels.hpp>
+#include <dynd/assignment.hpp>
+#include <dynd/option.hpp>
+#include <dynd/types/fixed_dim_type.hpp>
 #include <dynd/types/struct_type.hpp>
 
-#include "kernels/copy_from_numpy_kernel.hpp"
 #include "type_deduction.hpp"
 #include "type_functions.hpp"
 #include "types/pyobject_type.hpp"
@@ -27,169 +29,319 @@ using namespace std;
 
 namespace {
 
-struct strided_of_numpy_arrmeta {
-  dynd::fixed_dim_type_arrmeta sdt[NPY_MAXDIMS];
-  pydynd::nd::copy_from_numpy_arrmeta am;
+// One dimension walked by the copy, in the destination and the numpy source at once
+struct copy_dim {
+  intptr_t size;
+  intptr_t dst_stride;
+  intptr_t src_stride;
 };
 
-} // anonymous namespace
+/**
+ * Drops dimensions of size one, and merges each dimension into the next
+ * inner one when both arrays step over it as a continuation of the inner
+ * dimension. A C-contiguous copy in both arrays ends up with one dimension.
+ */
+void collapse_copy_dims(vector<copy_dim> &dims)
+{
+  vector<copy_dim> collapsed;
+  for (size_t i = 0; i < dims.size(); ++i) {
+    if (dims[i].size == 0) {
+      // Nothing to copy at all
+      collapsed.assign(1, dims[i]);
+      break;
+    }
+    if (dims[i].size != 1) {
+      collapsed.push_back(dims[i]);
+    }
+  }
+
+  size_t n = 0;
+  for (size_t i = 0; i < collapsed.size(); ++i) {
+    if (n > 0) {
+      copy_dim &outer = collapsed[n - 1];
+      const copy_dim &inner = collapsed[i];
+      if (outer.dst_stride == inner.dst_stride * inner.size && outer.src_stride == inner.src_stride * inner.size) {
+        outer.size *= inner.size;
+        outer.dst_stride = inner.dst_stride;
+        outer.src_stride = inner.src_stride;
+        continue;
+      }
+    }
+    collapsed[n++] = collapsed[i];
+  }
+  collapsed.resize(n);
+  dims.swap(collapsed);
+}
 
-/*
-void pydynd::nd::copy_from_numpy_callable::instantiate(dynd::nd::call_node *&node, char *DYND_UNUSED(data),
-                                                       dynd::nd::kernel_builder *ckb, const dynd::ndt::type &dst_tp,
-                                                       const char *dst_arrmeta, intptr_t DYND_UNUSED(nsrc),
-                                                       const dynd::ndt::type *src_tp, const char *const *src_arrmeta,
-                                                       dynd::kernel_request_t kernreq, intptr_t nkwd,
-                                                       const dynd::nd::array *kwds,
-                                                       const std::map<std::string, dynd::ndt::type> &tp_vars)
+template <typename T>
+void copy_strided_values(char *dst, intptr_t dst_stride, const char *src, intptr_t src_stride, intptr_t count)
 {
-  if (src_tp[0].get_id() != dynd::void_id) {
+  // memcpy of a fixed size compiles to a plain load and store, and is safe for unaligned numpy data
+  for (intptr_t i = 0; i < count; ++i, dst += dst_stride, src += src_stride) {
+    T value;
+    memcpy(&value, src, sizeof(T));
+    memcpy(dst, &value, sizeof(T));
+  }
+}
+
+/**
+ * Copies ``count`` elements of ``elsize`` bytes along one dimension,
+ * byte swapping each ``swap_size`` byte unit of an element when
+ * ``swap_size`` is greater than one.
+ */
+void copy_strided_elements(char *dst, intptr_t dst_stride, const char *src, intptr_t src_stride, intptr_t count,
+                           intptr_t elsize, intptr_t swap_size)
+{
+  if (swap_size > 1) {
+    for (intptr_t i = 0; i < count; ++i, dst += dst_stride, src += src_stride) {
+      for (intptr_t unit = 0; unit < elsize; unit += swap_size) {
+        reverse_copy(src + unit, src + unit + swap_size, dst + unit);
+      }
+    }
+    return;
+  }
+
+  if (dst_stride == elsize && src_stride == elsize) {
+    memcpy(dst, src, count * elsize);
+    return;
+  }
+
+  switch (elsize) {
+  case 1:
+    copy_strided_values<uint8_t>(dst, dst_stride, src, src_stride, count);
+    break;
+  case 2:
+    copy_strided_values<uint16_t>(dst, dst_stride, src, src_stride, count);
+    break;
+  case 4:
+    copy_strided_values<uint32_t>(dst, dst_stride, src, src_stride, count);
+    break;
+  case 8:
+    copy_strided_values<uint64_t>(dst, dst_stride, src, src_stride, count);
+    break;
+  case 16:
+    copy_strided_values<dynd::complex<double>>(dst, dst_stride, src, src_stride, count);
+    break;
+  default:
+    for (intptr_t i = 0; i < count; ++i, dst += dst_stride, src += src_stride) {
+      memcpy(dst, src, elsize);
+    }
+    break;
+  }
+}
+
+/**
+ * Walks all but the innermost of the collapsed dimensions, copying the
+ * innermost one with copy_strided_elements.
+ */
+void copy_raw_elements(const vector<copy_dim> &dims, char *dst, const char *src, intptr_t elsize,
+                       intptr_t swap_size)
+{
+  if (dims.empty()) {
+    copy_strided_elements(dst, elsize, src, elsize, 1, elsize, swap_size);
+    return;
+  }
+
+  const copy_dim &inner = dims.back();
+  intptr_t outer_ndim = dims.size() - 1;
+  vector<intptr_t> index(outer_ndim, 0);
+  while (true) {
+    copy_strided_elements(dst, inner.dst_stride, src, inner.src_stride, inner.size, elsize, swap_size);
+
+    // Advance the outer dimensions like an odometer
+    intptr_t i = outer_ndim - 1;
+    for (; i >= 0; --i) {
+      dst += dims[i].dst_stride;
+      src += dims[i].src_stride;
+      if (++index[i] != dims[i].size) {
+        break;
+      }
+      dst -= dims[i].dst_stride * dims[i].size;
+      src -= dims[i].src_stride * dims[i].size;
+      index[i] = 0;
+    }
+    if (i < 0) {
+      return;
+    }
+  }
+}
+
+/**
+ * The size of the units to byte swap in an element of type ``tp`` which
+ * is viewing numpy data of dtype ``dtype``, 1 if no swap is needed, or 0
+ * if the element can't be copied as raw bytes into ``tp``.
+ */
+intptr_t raw_copy_swap_size(const dynd::ndt::type &tp, PyArray_Descr *dtype)
+{
+  if (PyDataType_FLAGCHK(dtype, NPY_ITEM_HASOBJECT) || PyDataType_HASFIELDS(dtype) ||
+      PyDataType_HASSUBARRAY(dtype)) {
+    return 0;
+  }
+  if (!tp.is_builtin() && tp.get_id() != dynd::fixed_string_id) {
+    return 0;
+  }
+  if (static_cast<intptr_t>(tp.get_data_size()) != dtype->elsize ||
+      pydynd::_type_from_numpy_dtype(dtype, 0) != tp) {
+    return 0;
+  }
+
+  if (PyArray_ISNBO(dtype->byteorder)) {
+    return 1;
+  }
+  if (tp.get_id() == dynd::fixed_string_id) {
+    // Non-native UCS4 strings go through the general assignment
+    return 0;
+  }
+  return tp.get_base_id() == dynd::complex_kind_id ? dtype->elsize / 2 : dtype->elsize;
+}
+
+/**
+ * Assigns numpy data to the destination through a dynd view of it, for
+ * the element types the raw copy doesn't handle. This converts between
+ * types and reads object arrays with the pyobject assignment kernels.
+ */
+void assign_from_numpy_view(const dynd::ndt::type &dst_tp, const char *dst_arrmeta, char *dst_data,
+                            const vector<copy_dim> &dims, PyArray_Descr *dtype, const char *src_data,
+                            uintptr_t src_alignment)
+{
+  dynd::ndt::type src_el_tp;
+  if (PyDataType_ISOBJECT(dtype)) {
+    src_el_tp = dynd::ndt::make_type<pyobject_type>();
+  }
+  else if (!PyDataType_FLAGCHK(dtype, NPY_ITEM_HASOBJECT)) {
+    src_el_tp = pydynd::_type_from_numpy_dtype(dtype, src_alignment);
+  }
+  else {
     stringstream ss;
-    ss << "Cannot instantiate dynd::nd::callable copy_from_numpy with "
-          "signature (";
-    ss << src_tp[0] << ") -> " << dst_tp;
-    throw dynd::type_error(ss.str());
+    ss << "Cannot assign from numpy type " << pydynd::pyobject_repr((PyObject *)dtype) << " to dynd type " << dst_tp;
+    throw invalid_argument(ss.str());
   }
 
-  PyArray_Descr *dtype = *reinterpret_cast<PyArray_Descr *const *>(src_arrmeta[0]);
-  uintptr_t src_alignment = reinterpret_cast<const uintptr_t *>(src_arrmeta[0])[1];
+  vector<intptr_t> shape(dims.size());
+  vector<char> src_arrmeta(dims.size() * sizeof(dynd::fixed_dim_type_arrmeta) + src_el_tp.get_arrmeta_size());
+  dynd::fixed_dim_type_arrmeta *src_am = reinterpret_cast<dynd::fixed_dim_type_arrmeta *>(src_arrmeta.data());
+  for (size_t i = 0; i < dims.size(); ++i) {
+    shape[i] = dims[i].size;
+    src_am[i].dim_size = dims[i].size;
+    src_am[i].stride = dims[i].src_stride;
+  }
+  if (!src_el_tp.is_builtin()) {
+    pydynd::fill_arrmeta_from_numpy_dtype(src_el_tp, dtype, reinterpret_cast<char *>(src_am + dims.size()));
+  }
+  dynd::ndt::type src_tp = dynd::ndt::make_type(dims.size(), shape.data(), src_el_tp);
 
-  if (!PyDataType_FLAGCHK(dtype, NPY_ITEM_HASOBJECT)) {
-    // If there is no object type in the numpy type, get the dynd equivalent
-    // type and use it to do the copying
-    dynd::ndt::type src_view_tp = _type_from_numpy_dtype(dtype, src_alignment);
-    dynd::nd::array error_mode = dynd::assign_error_fractional;
-    dynd::nd::assign->instantiate(node, NULL, ckb, dst_tp, dst_arrmeta, 1, &src_view_tp, NULL, kernreq, 1,
-                                  &error_mode, std::map<std::string, dynd::ndt::type>());
+  dynd::nd::array kwd = dynd::nd::empty(dynd::ndt::make_type<dynd::ndt::option_type>(dynd::ndt::make_type<int>()));
+  *reinterpret_cast<int *>(kwd.data()) = static_cast<int>(dynd::assign_error_fractional);
+  const char *src_arrmeta_ptr = src_arrmeta.data();
+  char *src_data_ptr = const_cast<char *>(src_data);
+  dynd::nd::assign->call(dst_tp, dst_arrmeta, dst_data, 1, &src_tp, &src_arrmeta_ptr, &src_data_ptr, 1, &kwd,
+                         std::map<std::string, dynd::ndt::type>());
+}
 
+/**
+ * Copies numpy elements of dtype ``dtype`` into destination elements of
+ * type ``el_tp``, over the dimensions ``shared_dims`` shared by both.
+ */
+void copy_numpy_elements(const vector<copy_dim> &shared_dims, const dynd::ndt::type &el_tp, const char *el_arrmeta,
+                         char *dst_data, PyArray_Descr *dtype, const char *src_data, uintptr_t src_alignment)
+{
+  // Fewer, longer dimensions also mean longer strided runs for the assignment
+  // kernels in the general case, e.g. over a whole column of python strings
+  vector<copy_dim> dims(shared_dims);
+  collapse_copy_dims(dims);
+  if (dims.size() == 1 && dims[0].size == 0) {
     return;
   }
-  else if (PyDataType_ISOBJECT(dtype)) {
-    dynd::nd::base_callable *af = dynd::nd::assign.get();
-    dynd::ndt::type child_src_tp = dynd::ndt::make_type<pyobject_type>();
-    af->instantiate(node, NULL, ckb, dst_tp, dst_arrmeta, 1, &child_src_tp, NULL, kernreq, nkwd, kwds, tp_vars);
+
+  intptr_t swap_size = raw_copy_swap_size(el_tp, dtype);
+  if (swap_size > 0) {
+    copy_raw_elements(dims, dst_data, src_data, dtype->elsize, swap_size);
     return;
   }
-  else if (PyDataType_HASFIELDS(dtype)) {
-    if (dst_tp.get_id() != dynd::struct_id && dst_tp.get_id() != dynd::tuple_id) {
-      stringstream ss;
-      ss << "Cannot assign from numpy type " << pyobject_repr((PyObject *)dtype) << " to dynd type " << dst_tp;
-      throw invalid_argument(ss.str());
-    }
 
-    // Get the fields out of the numpy dtype
-    vector<PyArray_Descr *> field_dtypes_orig;
-    vector<std::string> field_names_orig;
-    vector<size_t> field_offsets_orig;
-    pydynd::extract_fields_from_numpy_struct(dtype, field_dtypes_orig, field_names_orig, field_offsets_orig);
-    intptr_t field_count = field_dtypes_orig.size();
-    if (field_count != dst_tp.extended<dynd::ndt::tuple_type>()->get_field_count()) {
+  if (PyDataType_HASFIELDS(dtype) && (el_tp.get_id() == dynd::struct_id || el_tp.get_id() == dynd::tuple_id)) {
+    vector<PyArray_Descr *> field_dtypes;
+    vector<std::string> field_names;
+    vector<size_t> field_offsets;
+    pydynd::extract_fields_from_numpy_struct(dtype, field_dtypes, field_names, field_offsets);
+    const dynd::ndt::tuple_type *tt = el_tp.extended<dynd::ndt::tuple_type>();
+    intptr_t field_count = tt->get_field_count();
+    if (static_cast<intptr_t>(field_dtypes.size()) != field_count) {
       stringstream ss;
-      ss << "Cannot assign from numpy type " << pyobject_repr((PyObject *)dtype) << " to dynd type " << dst_tp;
+      ss << "Cannot assign from numpy type " << pydynd::pyobject_repr((PyObject *)dtype) << " to dynd type " << el_tp;
       throw invalid_argument(ss.str());
     }
 
-    // Permute the numpy fields to match with the dynd fields
-    vector<PyArray_Descr *> field_dtypes;
-    vector<size_t> field_offsets;
-    if (dst_tp.get_id() == dynd::struct_id) {
-      field_dtypes.resize(field_count);
-      field_offsets.resize(field_count);
-      for (intptr_t i = 0; i < field_count; ++i) {
-        intptr_t src_i = dst_tp.extended<dynd::ndt::struct_type>()->get_field_index(field_names_orig[i]);
-        if (src_i >= 0) {
-          field_dtypes[src_i] = field_dtypes_orig[i];
-          field_offsets[src_i] = field_offsets_orig[i];
-        }
-        else {
+    // Copy each numpy field straight into the dynd field with its name, or at its position for tuples
+    const uintptr_t *dst_data_offsets = reinterpret_cast<const uintptr_t *>(el_arrmeta);
+    const uintptr_t *dst_arrmeta_offsets = tt->get_arrmeta_offsets_raw();
+    for (intptr_t src_i = 0; src_i < field_count; ++src_i) {
+      intptr_t dst_i = src_i;
+      if (el_tp.get_id() == dynd::struct_id) {
+        dst_i = el_tp.extended<dynd::ndt::struct_type>()->get_field_index(field_names[src_i]);
+        if (dst_i < 0) {
           stringstream ss;
-          ss << "Cannot assign from numpy type " << pyobject_repr((PyObject *)dtype) << " to dynd type " << dst_tp;
+          ss << "Cannot assign from numpy type " << pydynd::pyobject_repr((PyObject *)dtype) << " to dynd type "
+             << el_tp;
           throw invalid_argument(ss.str());
         }
       }
+      copy_numpy_elements(dims, tt->get_field_type(dst_i), el_arrmeta + dst_arrmeta_offsets[dst_i],
+                          dst_data + dst_data_offsets[dst_i], field_dtypes[src_i], src_data + field_offsets[src_i],
+                          src_alignment | field_offsets[src_i]);
     }
-    else {
-      // In the tuple case, use position instead of name
-      field_dtypes.swap(field_dtypes_orig);
-      field_offsets.swap(field_offsets_orig);
-    }
-
-    vector<dynd::ndt::type> src_fields_tp(field_count, dynd::ndt::make_type<void>());
-    vector<copy_from_numpy_arrmeta> src_arrmeta_values(field_count);
-    vector<const char *> src_fields_arrmeta(field_count);
-    for (intptr_t i = 0; i < field_count; ++i) {
-      src_arrmeta_values[i].src_dtype = field_dtypes[i];
-      src_arrmeta_values[i].src_alignment = src_alignment | field_offsets[i];
-      src_fields_arrmeta[i] = reinterpret_cast<const char *>(&src_arrmeta_values[i]);
-    }
-
-    const uintptr_t *dst_arrmeta_offsets = dst_tp.extended<dynd::ndt::tuple_type>()->get_arrmeta_offsets_raw();
-    dynd::shortvector<const char *> dst_fields_arrmeta(field_count);
-    for (intptr_t i = 0; i != field_count; ++i) {
-      dst_fields_arrmeta[i] = dst_arrmeta + dst_arrmeta_offsets[i];
-    }
-
-    // Todo: Remove this line
-    dynd::nd::callable af = dynd::nd::make_callable<copy_from_numpy_callable>();
-
-    const std::vector<dynd::ndt::type> &dst_fields_tp = dst_tp.extended<dynd::ndt::tuple_type>()->get_field_types();
-    const uintptr_t *dst_data_offsets = dst_tp.extended<dynd::ndt::tuple_type>()->get_data_offsets(dst_arrmeta);
-
-    intptr_t self_offset = ckb->size();
-    ckb->emplace_back<dynd::nd::tuple_unary_op_ck>(kernreq);
-    dynd::nd::tuple_unary_op_ck *self = ckb->get_at<dynd::nd::tuple_unary_op_ck>(self_offset);
-    self->m_fields.resize(field_count);
-    for (intptr_t i = 0; i < field_count; ++i) {
-      self = ckb->get_at<dynd::nd::tuple_unary_op_ck>(self_offset);
-      dynd::nd::tuple_unary_op_item &field = self->m_fields[i];
-      field.child_kernel_offset = ckb->size() - self_offset;
-      field.dst_data_offset = dst_data_offsets[i];
-      field.src_data_offset = field_offsets[i];
-      dynd::nd::array error_mode = dynd::ndt::traits<dynd::assign_error_mode>::na();
-      af->instantiate(node, NULL, ckb, dst_fields_tp[i], dst_fields_arrmeta[i], 1, &src_fields_tp[i],
-                      &src_fields_arrmeta[i], dynd::kernel_request_single, 1, &error_mode,
-                      std::map<std::string, dynd::ndt::type>());
-    }
-
     return;
   }
-  else {
-    stringstream ss;
-    ss << "TODO: implement assign from numpy type " << pyobject_repr((PyObject *)dtype) << " to dynd type " << dst_tp;
-    throw invalid_argument(ss.str());
+
+  // Rebuild the shared dimensions on top of the destination element for the general assignment
+  vector<intptr_t> shape(dims.size());
+  vector<char> dst_arrmeta(dims.size() * sizeof(dynd::fixed_dim_type_arrmeta) + el_tp.get_arrmeta_size());
+  dynd::fixed_dim_type_arrmeta *dst_am = reinterpret_cast<dynd::fixed_dim_type_arrmeta *>(dst_arrmeta.data());
+  for (size_t i = 0; i < dims.size(); ++i) {
+    shape[i] = dims[i].size;
+    dst_am[i].dim_size = dims[i].size;
+    dst_am[i].stride = dims[i].dst_stride;
+  }
+  if (el_tp.get_arrmeta_size() > 0) {
+    memcpy(dst_am + dims.size(), el_arrmeta, el_tp.get_arrmeta_size());
   }
+  assign_from_numpy_view(dynd::ndt::make_type(dims.size(), shape.data(), el_tp), dst_arrmeta.data(), dst_data, dims,
+                         dtype, src_data, src_alignment);
 }
-*/
 
-dynd::nd::callable pydynd::nd::copy_from_numpy =
-    dynd::nd::functional::elwise(dynd::nd::make_callable<pydynd::nd::copy_from_numpy_callable>());
+} // anonymous namespace
 
 void pydynd::nd::array_copy_from_numpy(const dynd::ndt::type &dst_tp, const char *dst_arrmeta, char *dst_data,
-                                       PyArrayObject *src_arr, const dynd::eval::eval_context *ectx)
+                                       PyArrayObject *src_arr, const dynd::eval::eval_context *DYND_UNUSED(ectx))
 {
   intptr_t src_ndim = PyArray_NDIM(src_arr);
+  PyArray_Descr *dtype = PyArray_DTYPE(src_arr);
+  const char *src_data = reinterpret_cast<const char *>(PyArray_DATA(src_arr));
+
+  vector<copy_dim> dims(src_ndim);
+  uintptr_t src_alignment = reinterpret_cast<uintptr_t>(src_data);
+  for (intptr_t i = 0; i < src_ndim; ++i) {
+    dims[i].size = PyArray_DIM(src_arr, (int)i);
+    dims[i].src_stride = dims[i].size != 1 ? PyArray_STRIDE(src_arr, (int)i) : 0;
+    src_alignment |= static_cast<uintptr_t>(dims[i].src_stride);
+  }
 
-  strided_of_numpy_arrmeta src_am_holder;
-  const char *src_am = reinterpret_cast<const char *>(&src_am_holder.sdt[NPY_MAXDIMS - src_ndim]);
-  // Fill in metadata for a multi-dim strided array, corresponding
-  // to the numpy array, with a void type at the end for the numpy
-  // specific data.
-  uintptr_t src_alignment = reinterpret_cast<uintptr_t>(PyArray_DATA(src_arr));
+  // Walk the destination's leading fixed dimensions alongside the numpy ones. Anything else, like
+  // broadcasting or var dimensions, goes through the general assignment.
+  dynd::ndt::type el_tp = dst_tp;
+  const char *el_arrmeta = dst_arrmeta;
   for (intptr_t i = 0; i < src_ndim; ++i) {
-    dynd::fixed_dim_type_arrmeta &am = src_am_holder.sdt[NPY_MAXDIMS - src_ndim + i];
-    am.dim_size = PyArray_DIM(src_arr, (int)i);
-    am.stride = am.dim_size != 1 ? PyArray_STRIDE(src_arr, (int)i) : 0;
-    src_alignment |= static_cast<uintptr_t>(am.stride);
-  }
-  dynd::ndt::type src_tp = dynd::ndt::make_type(src_ndim, PyArray_SHAPE(src_arr), dynd::ndt::make_type<void>());
-  src_am_holder.am.src_dtype = PyArray_DTYPE(src_arr);
-  src_am_holder.am.src_alignment = src_alignment;
-
-  char *src_data = reinterpret_cast<char *>(PyArray_DATA(src_arr));
-  const char *kwd_names[1] = {"broadcast"};
-  dynd::nd::array kwd_values[1] = {true};
-  pydynd::nd::copy_from_numpy->call(dst_tp, dst_arrmeta, dst_data, 1, &src_tp, &src_am, &src_data, 1, kwd_values,
-                                    std::map<std::string, dynd::ndt::type>());
+    const dynd::fixed_dim_type_arrmeta *am = reinterpret_cast<const dynd::fixed_dim_type_arrmeta *>(el_arrmeta);
+    if (el_tp.get_id() != dynd::fixed_dim_id || am->dim_size != dims[i].size) {
+      assign_from_numpy_view(dst_tp, dst_arrmeta, dst_data, dims, dtype, src_data, src_alignment);
+      return;
+    }
+    dims[i].dst_stride = am->stride;
+    el_tp = el_tp.extended<dynd::ndt::fixed_dim_type>()->get_element_type();
+    el_arrmeta += sizeof(dynd::fixed_dim_type_arrmeta);
+  }
+
+  copy_numpy_elements(dims, el_tp, el_arrmeta, dst_data, dtype, src_data, src_alignment);
 }
 
 #endif // DYND_NUMPY_INTEROP
@@ -3,8 +3,12 @@
 // BSD 2-Clause License, see LICENSE.txt
 //
 
+#include <dynd/functional.hpp>
+
 #include "functional.hpp"
 #include "callables/apply_pyobject_callable.hpp"
+#include "callables/apply_pyobject_chunk_callable.hpp"
+#include "callables/numpy_ufunc_callable.hpp"
 #include "callable_api.h"
 
 using namespace std;
@@ -15,6 +19,45 @@ nd::callable apply(const ndt::type &tp, PyObject *func)
   return nd::make_callable<pydynd::nd::functional::apply_pyobject_callable>(tp, func);
 }
 
+nd::callable apply_chunk(const ndt::type &tp, PyObject *func, intptr_t chunk_size)
+{
+  if (chunk_size <= 0) {
+    stringstream ss;
+    ss << "chunk size must be positive, got " << chunk_size;
+    throw invalid_argument(ss.str());
+  }
+  if (tp.extended<ndt::callable_type>()->get_return_type().is_symbolic()) {
+    stringstream ss;
+    ss << "applying " << pydynd::pyobject_repr(func) << " in chunks requires a concrete return type, got " << tp;
+    throw invalid_argument(ss.str());
+  }
+
+  return nd::make_callable<pydynd::nd::functional::apply_pyobject_chunk_callable>(tp, func, chunk_size);
+}
+
+nd::callable from_ufunc(PyObject *ufunc)
+{
+  if (!PyObject_TypeCheck(ufunc, &PyUFunc_Type)) {
+    stringstream ss;
+    ss << "expected a NumPy ufunc, got " << pydynd::pyobject_repr(ufunc);
+    throw dynd::type_error(ss.str());
+  }
+
+  PyUFuncObject *uf = reinterpret_cast<PyUFuncObject *>(ufunc);
+  if (uf->nout != 1) {
+    stringstream ss;
+    ss << "NumPy ufunc '" << uf->name << "' has " << uf->nout << " outputs, only ufuncs with one output are supported";
+    throw invalid_argument(ss.str());
+  }
+  if (uf->core_enabled) {
+    stringstream ss;
+    ss << "NumPy ufunc '" << uf->name << "' is a generalized ufunc, which is not supported";
+    throw invalid_argument(ss.str());
+  }
+
+  return nd::functional::elwise(nd::make_callable<pydynd::nd::functional::ufunc_dispatch_callable>(uf));
+}
+
 dynd::nd::callable &dynd_nd_callable_to_cpp_ref(PyObject *o)
 {
   if (dynd_nd_callable_to_ptr == NULL) {
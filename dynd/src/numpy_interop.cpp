@@ -8,6 +8,8 @@
 #if DYND_NUMPY_INTEROP
 
 #include <dynd/memblock/external_memory_block.hpp>
+#include <dynd/types/option_type.hpp>
+#include <dynd/types/string_type.hpp>
 
 #include "array_functions.hpp"
 #include "copy_from_numpy_arrfunc.hpp"
@@ -16,6 +18,43 @@
 
 using namespace std;
 
+namespace {
+
+/**
+ * Copies a numpy object array of python strings, where some may be None,
+ * into a new ``string`` or ``?string`` array. The element types are checked
+ * in one pass, which on Python 3.3+ also gathers the UTF-8 data of the
+ * strings, so an array without None is filled straight from it. Returns a
+ * null array if the elements aren't all strings or None.
+ */
+dynd::nd::array array_from_numpy_strings(PyArrayObject *obj)
+{
+  vector<pair<const char *, Py_ssize_t>> payloads;
+  dynd::ndt::type el_tp = pydynd::string_type_of_numpy_objects(obj, &payloads);
+  if (el_tp.get_id() == dynd::uninitialized_id) {
+    return dynd::nd::array();
+  }
+
+  dynd::nd::array result = dynd::nd::dtyped_empty(PyArray_NDIM(obj), PyArray_SHAPE(obj), el_tp);
+#if PY_VERSION_HEX >= 0x03030000
+  if (el_tp.get_id() != dynd::option_id) {
+    // The result is C-contiguous, the same order the strings were gathered in
+    dynd::string *dst = reinterpret_cast<dynd::string *>(result.data());
+    for (size_t i = 0; i < payloads.size(); ++i) {
+      dst[i].assign(payloads[i].first, payloads[i].second);
+    }
+    return result;
+  }
+#endif
+
+  // The option assignment kernel sets each run of None to NA with one call
+  pydynd::nd::array_copy_from_numpy(result.get_type(), result.get()->metadata(), result.data(), obj,
+                                    &dynd::eval::default_eval_context);
+  return result;
+}
+
+} // anonymous namespace
+
 void pydynd::fill_arrmeta_from_numpy_dtype(const dynd::ndt::type &dt, PyArray_Descr *d, char *arrmeta)
 {
   switch (dt.get_id()) {
@@ -101,6 +140,13 @@ dynd::nd::array pydynd::array_from_numpy_array(PyArrayObject *obj, uint32_t acce
 
   PyArray_Descr *dtype = PyArray_DESCR(obj);
 
+  if (PyDataType_ISOBJECT(dtype)) {
+    dynd::nd::array result = array_from_numpy_strings(obj);
+    if (!result.is_null()) {
+      return result;
+    }
+  }
+
   if (always_copy || PyDataType_FLAGCHK(dtype, NPY_ITEM_HASOBJECT)) {
     // TODO would be nicer without the extra type transformation of the
     // get_canonical_type call
@@ -10,12 +10,127 @@
 
 #if DYND_NUMPY_INTEROP
 
+#include <dynd/types/option_type.hpp>
+#include <dynd/types/string_type.hpp>
 #include <dynd/types/struct_type.hpp>
 
 #include <numpy/arrayscalars.h>
 
 using namespace std;
 
+namespace {
+
+// The number of conversions kept in each direction of the dtype/type cache
+const size_t numpy_type_cache_capacity = 64;
+
+struct dtype_cache_entry {
+  // A reference to the dtype keeps its identity from being reused
+  PyArray_Descr *dtype;
+  // The field names at the time of the conversion, since they can be reassigned
+  PyObject *names;
+  size_t data_alignment;
+  dynd::ndt::type tp;
+};
+
+struct type_cache_entry {
+  dynd::ndt::type tp;
+  PyArray_Descr *dtype;
+};
+
+// The caches are only used with the GIL held, which serializes them. Full
+// caches replace their entries in the order they were stored.
+vector<dtype_cache_entry> dtype_cache;
+size_t dtype_cache_next = 0;
+vector<type_cache_entry> type_cache;
+size_t type_cache_next = 0;
+pydynd::numpy_type_cache_stats cache_stats = {0, 0, 0, 0, 0};
+
+void release_dtype_cache_entry(dtype_cache_entry &entry)
+{
+  Py_DECREF(entry.dtype);
+  Py_XDECREF(entry.names);
+}
+
+} // anonymous namespace
+
+bool pydynd::numpy_dtype_cache_lookup(PyArray_Descr *d, size_t data_alignment, dynd::ndt::type &out_tp)
+{
+  for (const dtype_cache_entry &entry : dtype_cache) {
+    if (entry.dtype == d && entry.data_alignment == data_alignment && entry.names == d->names) {
+      ++cache_stats.dtype_hits;
+      out_tp = entry.tp;
+      return true;
+    }
+  }
+  ++cache_stats.dtype_misses;
+  return false;
+}
+
+void pydynd::numpy_dtype_cache_store(PyArray_Descr *d, size_t data_alignment, const dynd::ndt::type &tp)
+{
+  Py_INCREF(d);
+  Py_XINCREF(d->names);
+  dtype_cache_entry entry = {d, d->names, data_alignment, tp};
+  if (dtype_cache.size() < numpy_type_cache_capacity) {
+    dtype_cache.push_back(entry);
+    return;
+  }
+  release_dtype_cache_entry(dtype_cache[dtype_cache_next]);
+  dtype_cache[dtype_cache_next] = entry;
+  dtype_cache_next = (dtype_cache_next + 1) % numpy_type_cache_capacity;
+}
+
+PyArray_Descr *pydynd::numpy_type_cache_lookup(const dynd::ndt::type &tp)
+{
+  for (const type_cache_entry &entry : type_cache) {
+    // Types converted repeatedly are often the same instance, which avoids the structural comparison
+    if (entry.tp.extended() == tp.extended() || entry.tp == tp) {
+      ++cache_stats.type_hits;
+      // A dtype's field names can be reassigned, so each caller gets its own copy
+      return PyArray_DescrNew(entry.dtype);
+    }
+  }
+  ++cache_stats.type_misses;
+  return NULL;
+}
+
+void pydynd::numpy_type_cache_store(const dynd::ndt::type &tp, PyArray_Descr *d)
+{
+  type_cache_entry entry = {tp, PyArray_DescrNew(d)};
+  if (entry.dtype == NULL) {
+    throw std::exception();
+  }
+  if (type_cache.size() < numpy_type_cache_capacity) {
+    type_cache.push_back(entry);
+    return;
+  }
+  Py_DECREF(type_cache[type_cache_next].dtype);
+  type_cache[type_cache_next] = entry;
+  type_cache_next = (type_cache_next + 1) % numpy_type_cache_capacity;
+}
+
+pydynd::numpy_type_cache_stats pydynd::get_numpy_type_cache_stats()
+{
+  numpy_type_cache_stats stats = cache_stats;
+  stats.size = static_cast<intptr_t>(dtype_cache.size() + type_cache.size());
+  return stats;
+}
+
+void pydynd::clear_numpy_type_cache()
+{
+  for (dtype_cache_entry &entry : dtype_cache) {
+    release_dtype_cache_entry(entry);
+  }
+  dtype_cache.clear();
+  dtype_cache_next = 0;
+  for (type_cache_entry &entry : type_cache) {
+    Py_DECREF(entry.dtype);
+  }
+  type_cache.clear();
+  type_cache_next = 0;
+  cache_stats = numpy_type_cache_stats();
+}
+
 PyArray_Descr *pydynd::numpy_dtype_from__type(const dynd::ndt::type &tp)
 {
   switch (tp.get_id()) {
@@ -363,10 +478,55 @@ dynd::ndt::type pydynd::_type_of_numpy_scalar(PyObject *obj)
   throw dynd::type_error("could not deduce a pydynd type from the numpy scalar object");
 }
 
+dynd::ndt::type pydynd::string_type_of_numpy_objects(PyArrayObject *obj,
+                                                     std::vector<std::pair<const char *, Py_ssize_t>> *out_utf8)
+{
+  bool has_str = false, has_none = false, all_str = true;
+#if PY_VERSION_HEX >= 0x03030000
+  if (out_utf8 != NULL) {
+    out_utf8->reserve(PyArray_SIZE(obj));
+  }
+#endif
+  for_each_numpy_object(obj, [&](PyObject *el) {
+    if (el == Py_None) {
+      has_none = true;
+    }
+    else if (is_pystring(el)) {
+      has_str = true;
+#if PY_VERSION_HEX >= 0x03030000
+      if (out_utf8 != NULL && !has_none) {
+        out_utf8->emplace_back();
+        out_utf8->back().first = pyunicode_as_utf8(el, out_utf8->back().second);
+      }
+#endif
+    }
+    else {
+      all_str = false;
+    }
+    return all_str;
+  });
+
+  if (out_utf8 != NULL && has_none) {
+    out_utf8->clear();
+  }
+  if (!all_str || (has_none && !has_str)) {
+    return dynd::ndt::type();
+  }
+  dynd::ndt::type tp = dynd::ndt::make_type<dynd::ndt::string_type>();
+  return has_none ? dynd::ndt::make_type<dynd::ndt::option_type>(tp) : tp;
+}
+
 dynd::ndt::type pydynd::array_from_numpy_array2(PyArrayObject *obj)
 {
   PyArray_Descr *dtype = PyArray_DESCR(obj);
 
+  if (PyDataType_ISOBJECT(dtype)) {
+    dynd::ndt::type tp = string_type_of_numpy_objects(obj);
+    if (tp.get_id() != dynd::uninitialized_id) {
+      return dynd::ndt::make_type(PyArray_NDIM(obj), PyArray_SHAPE(obj), tp);
+    }
+  }
+
   if (PyDataType_FLAGCHK(dtype, NPY_ITEM_HASOBJECT)) {
     return dynd::ndt::make_type(PyArray_NDIM(obj), PyArray_SHAPE(obj),
                                 pydynd::_type_from_numpy_dtype(dtype).get_canonical_type());
@@ -12,6 +12,7 @@
 #include <dynd/types/bytes_type.hpp>
 #include <dynd/types/option_type.hpp>
 #include <dynd/types/struct_type.hpp>
+#include <dynd/types/tuple_type.hpp>
 #include <dynd/types/type_type.hpp>
 #include <dynd/types/var_dim_type.hpp>
 
@@ -272,27 +273,12 @@ void pydynd::register_nd_array_type_deduction(PyTypeObject *array_type, dynd::nd
   type_from_pyarray = get_type;
 }
 
-dynd::ndt::type pydynd::xtype_for_prefix(PyObject *obj)
+dynd::ndt::type pydynd::pyint_type_for(PyObject *obj, bool &out_negative)
 {
-  // If it's a Cython w_array
-  if (array_pytypeobject != nullptr) {
-    if (PyObject_TypeCheck(obj, array_pytypeobject)) {
-      return type_from_pyarray(obj);
-    }
-  }
-
-#if DYND_NUMPY_INTEROP
-  if (PyArray_Check(obj)) {
-    return array_from_numpy_array2((PyArrayObject *)obj);
-  }
-
-#endif // DYND_NUMPY_INTEROP
-  if (PyBool_Check(obj)) {
-    return ndt::make_type<bool>();
-  }
 #if PY_VERSION_HEX < 0x03000000
   if (PyInt_Check(obj)) {
     long value = PyInt_AS_LONG(obj);
+    out_negative = (value < 0);
 #if SIZEOF_LONG > SIZEOF_INT
     // Use a 32-bit int if it fits.
     if (value >= INT_MIN && value <= INT_MAX) {
@@ -306,12 +292,14 @@ dynd::ndt::type pydynd::xtype_for_prefix(PyObject *obj)
 #endif
   }
 #endif // PY_VERSION_HEX < 0x03000000
-  if (PyLong_Check(obj)) {
-    PY_LONG_LONG value = PyLong_AsLongLong(obj);
-    if (value == -1 && PyErr_Occurred()) {
-      throw runtime_error("error converting int value");
-    }
+  int overflow = 0;
+  PY_LONG_LONG value = PyLong_AsLongLongAndOverflow(obj, &overflow);
+  if (value == -1 && PyErr_Occurred()) {
+    throw runtime_error("error converting int value");
+  }
 
+  if (overflow == 0) {
+    out_negative = (value < 0);
     // Use a 32-bit int if it fits.
     if (value >= INT_MIN && value <= INT_MAX) {
       return ndt::make_type<int>();
@@ -321,6 +309,112 @@ dynd::ndt::type pydynd::xtype_for_prefix(PyObject *obj)
     }
   }
 
+  out_negative = (overflow < 0);
+  if (overflow > 0) {
+    PyLong_AsUnsignedLongLong(obj);
+    if (!PyErr_Occurred()) {
+      return ndt::make_type<uint64_t>();
+    }
+    PyErr_Clear();
+  }
+  return ndt::make_type<int128>();
+}
+
+bool pydynd::is_pytuple_record(PyObject *obj)
+{
+  if (!PyTuple_CheckExact(obj)) {
+    // Namedtuples and other subclasses
+    return true;
+  }
+
+  // The items are compared by kind, with all numbers alike, lists and
+  // tuples alike, and other objects compared by their Python type
+  PyTypeObject *kind = NULL;
+  Py_ssize_t size = PyTuple_GET_SIZE(obj);
+  for (Py_ssize_t i = 0; i < size; ++i) {
+    PyObject *item = PyTuple_GET_ITEM(obj, i);
+    PyTypeObject *item_kind;
+    if (item == Py_None) {
+      continue;
+    }
+#if PY_VERSION_HEX < 0x03000000
+    else if (PyInt_Check(item) || PyLong_Check(item) || PyFloat_Check(item) || PyComplex_Check(item)) {
+#else
+    else if (PyLong_Check(item) || PyFloat_Check(item) || PyComplex_Check(item)) {
+#endif
+      item_kind = &PyFloat_Type;
+    }
+    else if (PyList_Check(item) || PyTuple_CheckExact(item)) {
+      item_kind = &PyList_Type;
+    }
+    else {
+      item_kind = Py_TYPE(item);
+    }
+
+    if (kind == NULL) {
+      kind = item_kind;
+    }
+    else if (kind != item_kind) {
+      return true;
+    }
+  }
+  return false;
+}
+
+dynd::ndt::type pydynd::pytuple_record_type_for(PyObject *obj)
+{
+  Py_ssize_t size = PyTuple_GET_SIZE(obj);
+  std::vector<ndt::type> field_types(size);
+  for (Py_ssize_t i = 0; i < size; ++i) {
+    PyObject *item = PyTuple_GET_ITEM(obj, i);
+#if PY_VERSION_HEX >= 0x03000000
+    if (PyUnicode_Check(item)) {
+      field_types[i] = ndt::make_type<ndt::string_type>();
+    }
+    else if (PyLong_Check(item) && !PyBool_Check(item)) {
+#else
+    if ((PyInt_Check(item) || PyLong_Check(item)) && !PyBool_Check(item)) {
+#endif
+      bool negative = false;
+      field_types[i] = pyint_type_for(item, negative);
+    }
+    else if (PyTuple_Check(item) && is_pytuple_record(item)) {
+      field_types[i] = pytuple_record_type_for(item);
+    }
+    else {
+      field_types[i] = dynd_ndt_cpp_type_for(item);
+    }
+  }
+  return ndt::make_type<ndt::tuple_type>(field_types);
+}
+
+dynd::ndt::type pydynd::xtype_for_prefix(PyObject *obj)
+{
+  // If it's a Cython w_array
+  if (array_pytypeobject != nullptr) {
+    if (PyObject_TypeCheck(obj, array_pytypeobject)) {
+      return type_from_pyarray(obj);
+    }
+  }
+
+#if DYND_NUMPY_INTEROP
+  if (PyArray_Check(obj)) {
+    return array_from_numpy_array2((PyArrayObject *)obj);
+  }
+
+#endif // DYND_NUMPY_INTEROP
+  if (PyBool_Check(obj)) {
+    return ndt::make_type<bool>();
+  }
+#if PY_VERSION_HEX < 0x03000000
+  if (PyInt_Check(obj) || PyLong_Check(obj)) {
+#else
+  if (PyLong_Check(obj)) {
+#endif
+    bool negative = false;
+    return pyint_type_for(obj, negative);
+  }
+
   return dynd::ndt::type();
 }
 
@@ -330,15 +424,20 @@ dynd::ndt::type pydynd::ndt_type_from_pylist(PyObject *obj)
   // Do a pass through all the data to deduce its type and shape
   std::vector<intptr_t> shape;
   dynd::ndt::type tp = dynd::ndt::make_type<void>();
-  Py_ssize_t size = PyList_GET_SIZE(obj);
+  Py_ssize_t size = PySequence_Fast_GET_SIZE(obj);
   shape.push_back(size);
+  bool negative_int_seen = false;
   for (Py_ssize_t i = 0; i < size; ++i) {
-    deduce_pylist_shape_and_dtype(PyList_GET_ITEM(obj, i), shape, tp, 1);
+    deduce_pylist_shape_and_dtype(PySequence_Fast_GET_ITEM(obj, i), shape, tp, 1, negative_int_seen);
   }
 
   if (tp.get_id() == dynd::void_id) {
     tp = dynd::ndt::make_type<int32_t>();
   }
+  else if (tp.get_id() == dynd::uninitialized_id) {
+    // E.g. records with different numbers of fields
+    throw dynd::type_error("could not deduce a dynd type for the Python list");
+  }
 
   return dynd::ndt::make_type(shape.size(), shape.data(), tp);
 }